@@ -0,0 +1,156 @@
+#include "ActionDispatcher.h"
+#include <QDateTime>
+#include <QFile>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QRunnable>
+#include <QThread>
+#include <utility>
+
+ActionDispatcher::ActionDispatcher(QObject *parent)
+    : QObject(parent)
+{
+    pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), 4));
+    pool.setExpiryTimeout(10000);
+    clock.start();
+}
+
+ActionDispatcher::~ActionDispatcher()
+{
+    stopping.store(true, std::memory_order_relaxed);
+    waiting.clear();
+    pool.clear();
+    pool.waitForDone(ShutdownWaitMs);
+}
+
+void ActionDispatcher::dispatch(QVector<Job> jobs)
+{
+    qint64 now = clock.nsecsElapsed() / 1000;
+    for (Job &job : jobs) {
+        if (pendingTotal >= capacity) {
+            ++droppedCount;
+            continue;
+        }
+        ++pendingTotal;
+        job.queuedUs = now;
+        if (busy.contains(job.id)) {
+            waiting[job.id].enqueue(std::move(job));
+        } else {
+            busy.insert(job.id);
+            submit(std::move(job));
+        }
+    }
+}
+
+void ActionDispatcher::submit(Job job)
+{
+    pool.start(QRunnable::create([this, job = std::move(job)]() {
+        qint64 startUs = clock.nsecsElapsed() / 1000;
+        active.fetch_add(1, std::memory_order_relaxed);
+        bool ok = runJob(job);
+        active.fetch_sub(1, std::memory_order_relaxed);
+        qint64 runUs = clock.nsecsElapsed() / 1000 - startUs;
+
+        // Облік і наступне спрацювання того ж таймера — вже в потоці диспетчера
+        int id = job.id;
+        qint64 waitUs = startUs - job.queuedUs;
+        QMetaObject::invokeMethod(this, [this, id, waitUs, runUs, ok]() { jobDone(id, waitUs, runUs, ok); },
+                                  Qt::QueuedConnection);
+    }));
+}
+
+void ActionDispatcher::jobDone(int id, qint64 waitUs, qint64 runUs, bool ok)
+{
+    --pendingTotal;
+    ++completedCount;
+    if (!ok) ++failedCount;
+    queueLatency.record(waitUs);
+    runTime.record(runUs);
+
+    auto it = waiting.find(id);
+    if (it == waiting.end()) {
+        busy.remove(id);
+        return;
+    }
+    Job next = it->dequeue();
+    if (it->isEmpty()) waiting.erase(it);
+    submit(std::move(next));
+}
+
+// Дії виконуються до кінця списку навіть після помилки однієї з них
+bool ActionDispatcher::runJob(const Job &job)
+{
+    bool ok = true;
+    for (const TimerAction &action : job.actions) {
+        if (stopping.load(std::memory_order_relaxed)) return false;
+        QString error;
+        if (runAction(job, action, error)) continue;
+        ok = false;
+        emit actionFailed(job.id, action.toString(), error);
+    }
+    return ok;
+}
+
+bool ActionDispatcher::runAction(const Job &job, const TimerAction &action, QString &error)
+{
+    switch (action.kind) {
+    case TimerAction::Sound:
+        emit soundRequested(job.id, action.argument);
+        return true;
+
+    case TimerAction::Notify:
+        emit notificationRequested(job.id, job.name, action.argument);
+        return true;
+
+    case TimerAction::Log: {
+        QString line = QString("%1\t%2\t%3\n")
+                           .arg(QDateTime::currentDateTime().toString(Qt::ISODateWithMs))
+                           .arg(job.id)
+                           .arg(job.name);
+        QMutexLocker lock(&logMutex);
+        QFile file(action.argument);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            error = file.errorString();
+            return false;
+        }
+        file.write(line.toUtf8());
+        return true;
+    }
+
+    case TimerAction::Command: {
+        QProcess process;
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert("TIMER_ID", QString::number(job.id));
+        env.insert("TIMER_NAME", job.name);
+        process.setProcessEnvironment(env);
+        process.setProcessChannelMode(QProcess::ForwardedChannels);
+        process.startCommand(action.argument);
+        if (!process.waitForStarted()) {
+            error = process.errorString();
+            return false;
+        }
+        // Чекаємо частинами, щоб закриття диспетчера не чекало на тайм-аут команди
+        QElapsedTimer elapsed;
+        elapsed.start();
+        bool finished;
+        while (!(finished = process.waitForFinished(PollMs)) && process.state() != QProcess::NotRunning) {
+            if (stopping.load(std::memory_order_relaxed)) break;
+            if (commandTimeoutMs >= 0 && elapsed.elapsed() >= commandTimeoutMs) break;
+        }
+        if (!finished && process.state() != QProcess::NotRunning) {
+            process.kill();
+            process.waitForFinished();
+            error = stopping.load(std::memory_order_relaxed)
+                        ? QString("Перервано при завершенні")
+                        : QString("Перевищено час виконання (%1 мс)").arg(commandTimeoutMs);
+            return false;
+        }
+        if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0) {
+            error = QString("Код завершення %1").arg(process.exitCode());
+            return false;
+        }
+        return true;
+    }
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+#ifndef ACTIONDISPATCHER_H
+#define ACTIONDISPATCHER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
+#include <QSet>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include "TimerAction.h"
+#include "TimerStats.h"
+
+// Виконання дій при спрацюванні в обмеженому пулі потоків.
+// Менеджер передає спрацювання одним пакетом на прохід драйвера. Дії одного таймера виконуються строго
+// по черзі, і наступне його спрацювання чекає завершення попереднього; різні таймери йдуть паралельно.
+// Черга обмежена: понад capacity нові спрацювання відкидаються і рахуються — потік менеджера не блокується.
+// Усі методи, крім сигналів soundRequested і notificationRequested, — лише з потоку, де живе об'єкт
+class ActionDispatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Job {
+        int id;
+        QString name;
+        QVector<TimerAction> actions;
+        qint64 queuedUs = 0;
+    };
+
+    explicit ActionDispatcher(QObject *parent = nullptr);
+    // Черга відкидається, команди, що виконуються, вбиваються; дій, що вже йдуть, чекає не довше за ShutdownWaitMs
+    ~ActionDispatcher();
+
+    void dispatch(QVector<Job> jobs);
+
+    void setMaxThreads(int n) { pool.setMaxThreadCount(qMax(1, n)); }
+    int maxThreads() const { return pool.maxThreadCount(); }
+    void setCapacity(int n) { capacity = qMax(1, n); }
+    int queueCapacity() const { return capacity; }
+    void setCommandTimeout(int ms) { commandTimeoutMs = ms; }
+
+    // Спрацювання, що чекають на потік (прийняті, але ще не почались)
+    int queueDepth() const { return qMax(0, pendingTotal - active.load(std::memory_order_relaxed)); }
+    int running() const { return active.load(std::memory_order_relaxed); }
+    quint64 completed() const { return completedCount; }
+    quint64 failed() const { return failedCount; }
+    quint64 dropped() const { return droppedCount; }
+
+    LatencyHistogram queueLatency;  // мкс від спрацювання до початку виконання дій
+    LatencyHistogram runTime;       // мкс на виконання всіх дій одного спрацювання
+
+signals:
+    // Шлються з потоку пулу; звук і сповіщення показує застосунок у своєму потоці
+    void soundRequested(int id, const QString &file);
+    void notificationRequested(int id, const QString &name, const QString &text);
+    void actionFailed(int id, const QString &action, const QString &error);
+
+private:
+    static constexpr int ShutdownWaitMs = 2000;
+    static constexpr int PollMs = 100;     // як часто команда, що виконується, перевіряє stopping
+
+    QElapsedTimer clock;
+    int capacity = 10000;
+    int commandTimeoutMs = 30000;
+
+    QHash<int, QQueue<Job>> waiting;    // наступні спрацювання таймерів, дії яких ще виконуються
+    QSet<int> busy;
+    int pendingTotal = 0;
+    std::atomic<int> active{0};
+
+    quint64 completedCount = 0;
+    quint64 failedCount = 0;
+    quint64 droppedCount = 0;
+
+    QMutex logMutex;    // рядки журналів від різних потоків не перемішуються
+    std::atomic<bool> stopping{false};
+
+    // Останнім, тож руйнується першим: дії, що пережили ShutdownWaitMs, дочікуються ще при живих полях
+    QThreadPool pool;
+
+    void submit(Job job);
+    bool runJob(const Job &job);
+    bool runAction(const Job &job, const TimerAction &action, QString &error);
+    void jobDone(int id, qint64 waitUs, qint64 runUs, bool ok);
+};
+
+#endif // ACTIONDISPATCHER_H
@@ -10,6 +10,14 @@ AddTimerDialog::AddTimerDialog(QWidget *parent)
     hoursSpin = new QSpinBox(this); hoursSpin->setRange(0, 99);
     minutesSpin = new QSpinBox(this); minutesSpin->setRange(0, 59);
     secondsSpin = new QSpinBox(this); secondsSpin->setRange(0, 59);
+    millisecondsSpin = new QSpinBox(this); millisecondsSpin->setRange(0, 999); millisecondsSpin->setSingleStep(100);
+
+    // Порядок пунктів відповідає TimerSchedule::Kind
+    repeatCombo = new QComboBox(this);
+    repeatCombo->addItems({"Одноразовий", "Повторювати", "За розкладом"});
+    cronEdit = new QLineEdit(this);
+    cronEdit->setPlaceholderText("напр. 08:30 або 0 9 * * 1-5");
+    cronEdit->setEnabled(false);
 
     createButton = new QPushButton("Створити", this);
     cancelButton = new QPushButton("Скасувати", this);
@@ -19,6 +27,9 @@ AddTimerDialog::AddTimerDialog(QWidget *parent)
     formLayout->addRow("Години:", hoursSpin);
     formLayout->addRow("Хвилини:", minutesSpin);
     formLayout->addRow("Секунди:", secondsSpin);
+    formLayout->addRow("Мілісекунди:", millisecondsSpin);
+    formLayout->addRow("Повтор:", repeatCombo);
+    formLayout->addRow("Розклад:", cronEdit);
 
     QHBoxLayout *buttonLayout = new QHBoxLayout();
     buttonLayout->addWidget(createButton);
@@ -30,6 +41,9 @@ AddTimerDialog::AddTimerDialog(QWidget *parent)
 
     connect(createButton, &QPushButton::clicked, this, &AddTimerDialog::onCreateClicked);
     connect(cancelButton, &QPushButton::clicked, this, &QDialog::reject);
+    connect(repeatCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        cronEdit->setEnabled(index == TimerSchedule::Calendar);
+    });
 }
 
 QString AddTimerDialog::getName() const
@@ -37,9 +51,19 @@ QString AddTimerDialog::getName() const
     return nameEdit->text().trimmed();
 }
 
-int AddTimerDialog::getDurationSeconds() const
+TimerDuration AddTimerDialog::getDuration() const
+{
+    return std::chrono::hours(hoursSpin->value()) + std::chrono::minutes(minutesSpin->value())
+           + std::chrono::seconds(secondsSpin->value()) + TimerDuration(millisecondsSpin->value());
+}
+
+TimerSchedule AddTimerDialog::getSchedule() const
 {
-    return hoursSpin->value() * 3600 + minutesSpin->value() * 60 + secondsSpin->value();
+    switch (repeatCombo->currentIndex()) {
+    case TimerSchedule::Repeat: return TimerSchedule::repeat();
+    case TimerSchedule::Calendar: return TimerSchedule::calendar(CronSchedule::parse(cronEdit->text()));
+    default: return TimerSchedule::once();
+    }
 }
 
 void AddTimerDialog::onCreateClicked()
@@ -48,6 +72,13 @@ void AddTimerDialog::onCreateClicked()
         QMessageBox::warning(this, "Помилка", "Введіть назву таймера!");
         return;
     }
-    emit timerCreated(getName(), getDurationSeconds());
+    if (repeatCombo->currentIndex() == TimerSchedule::Calendar) {
+        QString error;
+        if (!CronSchedule::parse(cronEdit->text(), &error).isValid()) {
+            QMessageBox::warning(this, "Помилка", error);
+            return;
+        }
+    }
+    emit timerCreated(getName(), getDuration(), getSchedule());
     accept();
 }
\ No newline at end of file
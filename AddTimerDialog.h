@@ -4,10 +4,13 @@
 #include <QDialog>
 #include <QLineEdit>
 #include <QSpinBox>
+#include <QComboBox>
 #include <QPushButton>
 #include <QFormLayout>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
+#include "TimerDuration.h"
+#include "TimerSchedule.h"
 
 class AddTimerDialog : public QDialog
 {
@@ -16,10 +19,11 @@ public:
     explicit AddTimerDialog(QWidget *parent = nullptr);
 
     QString getName() const;
-    int getDurationSeconds() const;
+    TimerDuration getDuration() const;
+    TimerSchedule getSchedule() const;
 
 signals:
-    void timerCreated(const QString &name, int durationSeconds);
+    void timerCreated(const QString &name, TimerDuration duration, const TimerSchedule &schedule);
 
 private slots:
     void onCreateClicked();
@@ -29,6 +33,9 @@ private:
     QSpinBox *hoursSpin;
     QSpinBox *minutesSpin;
     QSpinBox *secondsSpin;
+    QSpinBox *millisecondsSpin;
+    QComboBox *repeatCombo;
+    QLineEdit *cronEdit;
     QPushButton *createButton;
     QPushButton *cancelButton;
 };
@@ -0,0 +1,23 @@
+#include "TimerStats.h"
+#include <cstdlib>
+#include <new>
+
+// Заміна глобальних operator new/delete: кожне виділення лише збільшує атомарний лічильник.
+// Масивні й nothrow-варіанти стандартної бібліотеки йдуть через ці ж функції.
+
+void *operator new(std::size_t size)
+{
+    TimerStats::noteAllocation();
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
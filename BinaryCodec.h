@@ -0,0 +1,144 @@
+#ifndef BINARYCODEC_H
+#define BINARYCODEC_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtEndian>
+#include "TimerSchedule.h"
+#include "TimerAction.h"
+
+// Компактне двійкове кодування для сховища і протоколу IPC:
+// числа — little-endian, рядки — quint16 довжина + UTF-16.
+namespace BinaryCodec {
+
+template <typename T>
+void put(QByteArray &out, T value)
+{
+    char buf[sizeof(T)];
+    qToLittleEndian(value, buf);
+    out.append(buf, sizeof(T));
+}
+
+inline void putString(QByteArray &out, const QString &text)
+{
+    quint16 len = quint16(qMin(text.size(), 0xFFFF));
+    put(out, len);
+    const char16_t *utf16 = reinterpret_cast<const char16_t*>(text.utf16());
+    for (int i = 0; i < len; ++i) put(out, quint16(utf16[i]));
+}
+
+inline void putSchedule(QByteArray &out, const TimerSchedule &schedule)
+{
+    put(out, quint8(schedule.kind));
+    putString(out, schedule.kind == TimerSchedule::Calendar ? schedule.cron.expression() : QString());
+}
+
+inline void putActions(QByteArray &out, const QVector<TimerAction> &actions)
+{
+    quint8 count = quint8(qMin(actions.size(), 0xFF));
+    put(out, count);
+    for (int i = 0; i < count; ++i) {
+        put(out, quint8(actions[i].kind));
+        putString(out, actions[i].argument);
+    }
+}
+
+// Беззнакове число змінної довжини: по 7 біт у байті, старший біт — "далі ще байт".
+// Для дельт часу й індексів, що здебільшого вміщаються в один-два байти
+inline void putVarint(QByteArray &out, quint64 value)
+{
+    while (value >= 0x80) {
+        out.append(char(value | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+// Послідовне читання з буфера (або відображеного в пам'ять файлу) з перевіркою меж
+class Reader
+{
+public:
+    Reader(const uchar *data, qint64 size) : p(data), end(data + size) {}
+    explicit Reader(const QByteArray &data)
+        : Reader(reinterpret_cast<const uchar*>(data.constData()), data.size()) {}
+
+    bool atEnd() const { return p >= end; }
+    const uchar *pos() const { return p; }
+
+    template <typename T>
+    bool get(T &value)
+    {
+        if (end - p < qint64(sizeof(T))) return false;
+        value = qFromLittleEndian<T>(p);
+        p += sizeof(T);
+        return true;
+    }
+
+    bool getVarint(quint64 &value)
+    {
+        value = 0;
+        for (int shift = 0; p < end && shift < 64; shift += 7) {
+            uchar b = *p++;
+            value |= quint64(b & 0x7F) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool skip(qint64 bytes)
+    {
+        if (bytes < 0 || end - p < bytes) return false;
+        p += bytes;
+        return true;
+    }
+
+    bool getString(QString &text)
+    {
+        quint16 len;
+        if (!get(len) || end - p < qint64(len) * 2) return false;
+        text.resize(len);
+        char16_t *dst = reinterpret_cast<char16_t*>(text.data());
+        for (int i = 0; i < len; ++i) dst[i] = qFromLittleEndian<quint16>(p + i * 2);
+        p += len * 2;
+        return true;
+    }
+
+    // Невідомий вид або некоректний вираз cron читаються як одноразовий таймер
+    bool getSchedule(TimerSchedule &schedule)
+    {
+        quint8 kind;
+        QString expression;
+        if (!get(kind) || !getString(expression)) return false;
+        schedule = TimerSchedule();
+        if (kind == TimerSchedule::Repeat) {
+            schedule = TimerSchedule::repeat();
+        } else if (kind == TimerSchedule::Calendar) {
+            CronSchedule cron = CronSchedule::parse(expression);
+            if (cron.isValid()) schedule = TimerSchedule::calendar(cron);
+        }
+        return true;
+    }
+
+    // Дії невідомого виду пропускаються
+    bool getActions(QVector<TimerAction> &actions)
+    {
+        quint8 count;
+        if (!get(count)) return false;
+        actions.clear();
+        for (int i = 0; i < count; ++i) {
+            quint8 kind;
+            QString argument;
+            if (!get(kind) || !getString(argument)) return false;
+            if (kind <= TimerAction::Notify) actions.append(TimerAction{TimerAction::Kind(kind), argument});
+        }
+        return true;
+    }
+
+private:
+    const uchar *p;
+    const uchar *end;
+};
+
+} // namespace BinaryCodec
+
+#endif // BINARYCODEC_H
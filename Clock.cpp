@@ -0,0 +1,108 @@
+#include "Clock.h"
+#include <QDateTime>
+#include <QDeadlineTimer>
+
+namespace {
+
+class SystemClock : public Clock
+{
+public:
+    qint64 monotonicMs() const override { return QDeadlineTimer::current(Qt::PreciseTimer).deadline(); }
+    qint64 wallMs() const override { return QDateTime::currentMSecsSinceEpoch(); }
+};
+
+} // namespace
+
+Clock *Clock::system()
+{
+    static SystemClock clock;
+    return &clock;
+}
+
+SimulatedClock::SimulatedClock(qint64 wallStartMs)
+    : wallOrigin(wallStartMs)
+{
+}
+
+QPair<qint64, quint64> SimulatedClock::schedule(ClockTimer *timer, qint64 deadline)
+{
+    QPair<qint64, quint64> key(qMax(deadline, current), nextSeq++);
+    queue.insert(key, timer);
+    return key;
+}
+
+void SimulatedClock::advanceTo(qint64 targetMs)
+{
+    // Обробник може запустити нові таймери в межах кроку — вони спрацюють у цьому ж виклику
+    while (!queue.isEmpty() && queue.firstKey().first <= targetMs) {
+        auto it = queue.begin();
+        current = it.key().first;
+        ClockTimer *timer = it.value();
+        queue.erase(it);
+        ++fired;
+        timer->fire();
+    }
+    current = qMax(current, targetMs);
+}
+
+ClockTimer::ClockTimer(QObject *parent)
+    : QObject(parent)
+{
+    connect(&timer, &QTimer::timeout, this, &ClockTimer::timeout);
+}
+
+ClockTimer::~ClockTimer()
+{
+    stop();
+}
+
+void ClockTimer::setClock(Clock *clock)
+{
+    stop();
+    sim = clock ? clock->simulated() : nullptr;
+}
+
+void ClockTimer::setSingleShot(bool value)
+{
+    singleShot = value;
+    timer.setSingleShot(value);
+}
+
+void ClockTimer::setInterval(int ms)
+{
+    intervalMs = ms;
+    timer.setInterval(ms);
+}
+
+void ClockTimer::start(int ms)
+{
+    intervalMs = ms;
+    if (!sim) {
+        timer.start(ms);
+        return;
+    }
+    if (simActive) sim->cancel(simKey);
+    simKey = sim->schedule(this, sim->monotonicMs() + ms);
+    simActive = true;
+}
+
+void ClockTimer::stop()
+{
+    if (!sim) {
+        timer.stop();
+        return;
+    }
+    if (simActive) sim->cancel(simKey);
+    simActive = false;
+}
+
+void ClockTimer::fire()
+{
+    // Повторюваний таймер ставиться знову ще до сигналу — обробник може його зупинити
+    simActive = false;
+    if (!singleShot) {
+        simKey = sim->schedule(this, simKey.first + qMax(1, intervalMs));
+        simActive = true;
+    }
+    emit timeout();
+}
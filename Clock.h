@@ -0,0 +1,105 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <QObject>
+#include <QMap>
+#include <QPair>
+#include <QTimer>
+#include "TimerDuration.h"
+
+class SimulatedClock;
+class ClockTimer;
+
+// Джерело часу для менеджера таймерів: монотонний час (дедлайни) і настінний (розклади cron, сховище).
+// Типово — системний годинник; симульований просувається вручну і дозволяє прогнати добу за мілісекунди
+class Clock
+{
+public:
+    virtual ~Clock() = default;
+
+    virtual qint64 monotonicMs() const = 0;
+    virtual qint64 wallMs() const = 0;
+    virtual SimulatedClock *simulated() { return nullptr; }
+
+    static Clock *system();
+};
+
+// Симульований час. Таймери ClockTimer на цьому годиннику спрацьовують лише під час advance():
+// по черзі в порядку дедлайнів (за рівності — в порядку запуску), і на момент спрацювання
+// годинник показує саме їхній дедлайн. Тож і сигнали менеджера йдуть детерміновано
+class SimulatedClock : public Clock
+{
+public:
+    // Типовий настінний час — 2024-01-01 00:00 UTC
+    explicit SimulatedClock(qint64 wallStartMs = 1704067200000LL);
+
+    qint64 monotonicMs() const override { return current; }
+    qint64 wallMs() const override { return wallOrigin + current; }
+    SimulatedClock *simulated() override { return this; }
+
+    void advance(TimerDuration delta) { advanceTo(current + qMax<qint64>(0, delta.count())); }
+    void advanceTo(qint64 targetMs);
+
+    // Переведення настінного годинника без руху монотонного
+    void setWallMs(qint64 wallMs) { wallOrigin = wallMs - current; }
+
+    int pendingTimers() const { return queue.size(); }
+    qint64 nextEventMs() const { return queue.isEmpty() ? -1 : queue.firstKey().first; }
+
+    // Скільки таймерів спрацювало за весь час
+    quint64 firedCount() const { return fired; }
+
+private:
+    friend class ClockTimer;
+
+    qint64 current = 0;
+    qint64 wallOrigin;
+    quint64 nextSeq = 0;
+    quint64 fired = 0;
+    QMap<QPair<qint64, quint64>, ClockTimer*> queue;
+
+    QPair<qint64, quint64> schedule(ClockTimer *timer, qint64 deadline);
+    void cancel(const QPair<qint64, quint64> &key) { queue.remove(key); }
+};
+
+// Таймер з інтерфейсом QTimer, що йде за обраним Clock: на системному — звичайний QTimer,
+// на симульованому — запис у черзі годинника
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockTimer(QObject *parent = nullptr);
+    ~ClockTimer();
+
+    // Активний таймер зупиняється
+    void setClock(Clock *clock);
+
+    void setSingleShot(bool singleShot);
+    bool isSingleShot() const { return singleShot; }
+    void setInterval(int ms);
+    int interval() const { return intervalMs; }
+    void setTimerType(Qt::TimerType type) { timer.setTimerType(type); }
+    bool isActive() const { return sim ? simActive : timer.isActive(); }
+
+    void start(int ms);
+    void start() { start(intervalMs); }
+    void stop();
+
+signals:
+    void timeout();
+
+private:
+    friend class SimulatedClock;
+
+    QTimer timer;
+    SimulatedClock *sim = nullptr;
+    bool singleShot = false;
+    int intervalMs = 0;
+    bool simActive = false;
+    QPair<qint64, quint64> simKey;
+
+    void fire();
+};
+
+#endif // CLOCK_H
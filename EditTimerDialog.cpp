@@ -28,9 +28,12 @@ void EditTimerDialog::setupUi()
     durationHours = new QSpinBox();
     durationMinutes = new QSpinBox();
     durationSeconds = new QSpinBox();
+    durationMilliseconds = new QSpinBox();
     durationHours->setRange(0, 99);
     durationMinutes->setRange(0, 59);
     durationSeconds->setRange(0, 59);
+    durationMilliseconds->setRange(0, 999);
+    durationMilliseconds->setSingleStep(100);
 
     QHBoxLayout *durationLayout = new QHBoxLayout();
     durationLayout->addWidget(new QLabel(tr("Години:")));
@@ -39,11 +42,35 @@ void EditTimerDialog::setupUi()
     durationLayout->addWidget(durationMinutes);
     durationLayout->addWidget(new QLabel(tr("Секунди:")));
     durationLayout->addWidget(durationSeconds);
+    durationLayout->addWidget(new QLabel(tr("Мс:")));
+    durationLayout->addWidget(durationMilliseconds);
     durationLayout->addStretch();
 
     inputLayout->addWidget(new QLabel(tr("Тривалість:")), 1, 0);
     inputLayout->addLayout(durationLayout, 1, 1, 1, 2);
 
+    // Повторення; порядок пунктів відповідає TimerSchedule::Kind
+    repeatCombo = new QComboBox();
+    repeatCombo->addItems({tr("Одноразовий"), tr("Повторювати"), tr("За розкладом")});
+    cronEdit = new QLineEdit();
+    cronEdit->setPlaceholderText(tr("напр. 08:30 або 0 9 * * 1-5"));
+    cronEdit->setEnabled(false);
+    connect(repeatCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        cronEdit->setEnabled(index == TimerSchedule::Calendar);
+    });
+
+    inputLayout->addWidget(new QLabel(tr("Повтор:")), 2, 0);
+    inputLayout->addWidget(repeatCombo, 2, 1);
+    inputLayout->addWidget(cronEdit, 2, 2);
+
+    // Дії при спрацюванні, по одній на рядок
+    actionsEdit = new QPlainTextEdit();
+    actionsEdit->setPlaceholderText(tr("звук\nкоманда: notify-send \"$TIMER_NAME\"\nжурнал: /шлях/до/файлу.log\nсповіщення: текст"));
+    actionsEdit->setTabChangesFocus(true);
+    actionsEdit->setFixedHeight(actionsEdit->fontMetrics().lineSpacing() * 5 + 12);
+    inputLayout->addWidget(new QLabel(tr("Дії:")), 3, 0, Qt::AlignTop);
+    inputLayout->addWidget(actionsEdit, 3, 1, 1, 2);
+
     mainLayout->addLayout(inputLayout);
     mainLayout->addSpacing(20);
 
@@ -60,17 +87,23 @@ void EditTimerDialog::setupUi()
     setLayout(mainLayout);
 }
 
-void EditTimerDialog::setTimerData(TimerEntry *entry)
+void EditTimerDialog::setTimerData(const TimerView &entry)
 {
     if (!entry) return;
 
-    currentId = QString::number(entry->id);
-    nameEdit->setText(entry->name);
+    currentId = QString::number(entry.id());
+    nameEdit->setText(entry.name());
 
-    qint64 totalSeconds = entry->durationSeconds;
+    qint64 totalMs = entry.duration().count();
+    qint64 totalSeconds = totalMs / 1000;
     durationHours->setValue(totalSeconds / 3600);
     durationMinutes->setValue((totalSeconds % 3600) / 60);
     durationSeconds->setValue(totalSeconds % 60);
+    durationMilliseconds->setValue(totalMs % 1000);
+
+    repeatCombo->setCurrentIndex(entry.schedule().kind);
+    cronEdit->setText(entry.schedule().cron.expression());
+    actionsEdit->setPlainText(TimerAction::formatList(entry.actions()));
 }
 
 void EditTimerDialog::on_save_clicked()
@@ -81,15 +114,37 @@ void EditTimerDialog::on_save_clicked()
         return;
     }
 
-    qint64 totalDurationSeconds = static_cast<qint64>(durationHours->value()) * 3600 +
-    static_cast<qint64>(durationMinutes->value()) * 60 +
-    static_cast<qint64>(durationSeconds->value());
+    TimerDuration totalDuration = std::chrono::hours(durationHours->value()) +
+    std::chrono::minutes(durationMinutes->value()) +
+    std::chrono::seconds(durationSeconds->value()) +
+    TimerDuration(durationMilliseconds->value());
+
+    TimerSchedule schedule;
+    if (repeatCombo->currentIndex() == TimerSchedule::Repeat) {
+        schedule = TimerSchedule::repeat();
+    } else if (repeatCombo->currentIndex() == TimerSchedule::Calendar) {
+        QString error;
+        CronSchedule cron = CronSchedule::parse(cronEdit->text(), &error);
+        if (!cron.isValid()) {
+            QMessageBox::warning(this, tr("Помилка"), error);
+            return;
+        }
+        schedule = TimerSchedule::calendar(cron);
+    }
 
-    if (totalDurationSeconds <= 0) {
+    // Таймеру за розкладом тривалість не потрібна: спрацювання задає розклад
+    if (schedule.kind != TimerSchedule::Calendar && totalDuration <= TimerDuration::zero()) {
         QMessageBox::warning(this, tr("Помилка"), tr("Тривалість таймера має бути більшою за нуль."));
         return;
     }
 
-    emit timerEdited(currentId, name, totalDurationSeconds);
+    QString actionsError;
+    QVector<TimerAction> actions = TimerAction::parseList(actionsEdit->toPlainText(), &actionsError);
+    if (!actionsError.isEmpty()) {
+        QMessageBox::warning(this, tr("Помилка"), actionsError);
+        return;
+    }
+
+    emit timerEdited(currentId, name, totalDuration, schedule, actions);
     accept();
 }
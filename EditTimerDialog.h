@@ -5,11 +5,16 @@
 #include <QLabel>
 #include <QLineEdit>
 #include <QSpinBox>
+#include <QComboBox>
+#include <QPlainTextEdit>
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
+#include "TimerDuration.h"
+#include "TimerSchedule.h"
+#include "TimerAction.h"
 
-struct TimerEntry;
+class TimerView;
 
 class EditTimerDialog : public QDialog
 {
@@ -17,19 +22,22 @@ class EditTimerDialog : public QDialog
 public:
     explicit EditTimerDialog(QWidget *parent = nullptr);
 
-    void setTimerData(TimerEntry *entry);
+    void setTimerData(const TimerView &entry);
 
     QLineEdit* getNameEdit() const { return nameEdit; }
     QSpinBox* getHours() const { return durationHours; }
     QSpinBox* getMinutes() const { return durationMinutes; }
     QSpinBox* getSeconds() const { return durationSeconds; }
+    QSpinBox* getMilliseconds() const { return durationMilliseconds; }
     void setSaveButtonEnabled(bool enabled) { saveButton->setEnabled(enabled); }
+    void setActionsEnabled(bool enabled) { actionsEdit->setEnabled(enabled); }
 
 private slots:
     void on_save_clicked();
 
 signals:
-    void timerEdited(const QString& id, const QString& name, qint64 durationSeconds);
+    void timerEdited(const QString& id, const QString& name, TimerDuration duration, const TimerSchedule &schedule,
+                     const QVector<TimerAction> &actions);
 
 private:
     QString currentId;
@@ -38,6 +46,10 @@ private:
     QSpinBox *durationHours;
     QSpinBox *durationMinutes;
     QSpinBox *durationSeconds;
+    QSpinBox *durationMilliseconds;
+    QComboBox *repeatCombo;
+    QLineEdit *cronEdit;
+    QPlainTextEdit *actionsEdit;
 
     QPushButton *saveButton;
     QPushButton *cancelButton;
@@ -0,0 +1,93 @@
+#ifndef EXPIRYORDER_H
+#define EXPIRYORDER_H
+
+#include <QHash>
+#include <QVector>
+#include <QtGlobal>
+#include <set>
+
+// Впорядкований індекс таймерів "хто спрацює раніше".
+// Запущені таймери спадають з однаковою швидкістю, тож їхній порядок за дедлайном змінюється
+// лише при старті, паузі, редагуванні чи спрацюванні. Таймери на паузі впорядковані за залишком.
+// Оновлення — O(log n), k найближчих — O(k); жодного сортування на тік.
+class ExpiryOrder
+{
+public:
+    bool isEmpty() const { return keyById.isEmpty(); }
+    int size() const { return keyById.size(); }
+
+    // Накладні витрати вузла червоно-чорного дерева: три вказівники і колір (з вирівнюванням)
+    static constexpr int TreeNodeBytes = 4 * sizeof(void*);
+
+    qint64 memoryBytes() const
+    {
+        return qint64(order.size()) * (TreeNodeBytes + sizeof(Key))
+               + keyById.capacity() * qint64(sizeof(int) + sizeof(Key) + 1);
+    }
+
+    void setRunning(int id, qint64 deadline) { place(id, Key{false, deadline, id}); }
+    void setPaused(int id, qint64 remaining) { place(id, Key{true, remaining, id}); }
+
+    void remove(int id)
+    {
+        auto it = keyById.find(id);
+        if (it == keyById.end()) return;
+        order.erase(it.value());
+        keyById.erase(it);
+    }
+
+    void clear()
+    {
+        order.clear();
+        keyById.clear();
+    }
+
+    // До k запущених таймерів з найближчими дедлайнами
+    QVector<int> nextToExpire(int k) const
+    {
+        QVector<int> ids;
+        for (auto it = order.begin(); it != order.end() && !it->paused && ids.size() < k; ++it) ids.append(it->id);
+        return ids;
+    }
+
+    // Спершу запущені за дедлайном, далі ті, що на паузі, за залишком
+    QVector<int> ordered() const
+    {
+        QVector<int> ids;
+        ids.reserve(int(order.size()));
+        for (const Key &key : order) ids.append(key.id);
+        return ids;
+    }
+
+private:
+    struct Key {
+        bool paused;
+        qint64 key;
+        int id;
+
+        bool operator<(const Key &o) const
+        {
+            if (paused != o.paused) return !paused;
+            if (key != o.key) return key < o.key;
+            return id < o.id;
+        }
+    };
+
+    std::set<Key> order;
+    QHash<int, Key> keyById;
+
+    void place(int id, const Key &key)
+    {
+        auto it = keyById.find(id);
+        if (it != keyById.end()) {
+            if (!(it.value() < key) && !(key < it.value())) return;
+            order.erase(it.value());
+            it.value() = key;
+        } else {
+            keyById.insert(id, key);
+        }
+        order.insert(key);
+    }
+};
+
+#endif // EXPIRYORDER_H
@@ -0,0 +1,135 @@
+#ifndef GROUPCLOCKS_H
+#define GROUPCLOCKS_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Віртуальні годинники груп таймерів. Група 0 — сам монотонний годинник.
+// Час групи на паузі заморожений, інакше це час батьківської групи мінус зсув.
+// Дедлайни таймерів групи задані в її часі, тож пауза, продовження і зсув групи змінюють
+// лише її годинник (O(глибини вкладення)) і жодного таймера не чіпають.
+class GroupClocks
+{
+public:
+    struct Group {
+        QString name;
+        int parent = 0;
+        bool live = false;
+        bool paused = false;
+        qint64 offset = 0;  // час батька мінус час групи, поки група йде
+        qint64 frozen = 0;  // час групи, поки вона на паузі
+    };
+
+    int create(const QString &name, int parent)
+    {
+        Group g;
+        g.name = name;
+        g.parent = contains(parent) ? parent : 0;
+        g.live = true;
+        groups.append(g);
+        return groups.size();
+    }
+
+    // Відновлення з тим самим id; батько має бути відновлений раніше
+    void restore(int id, const QString &name, int parent, bool paused, qint64 now, qint64 time)
+    {
+        if (id > groups.size()) groups.resize(id);
+        Group &g = groups[id - 1];
+        g = Group();
+        g.name = name;
+        g.parent = contains(parent) ? parent : 0;
+        g.live = true;
+        g.paused = paused;
+        setTime(id, now, time);
+    }
+
+    void remove(int id)
+    {
+        if (contains(id)) groups[id - 1] = Group();
+    }
+
+    bool contains(int id) const { return id > 0 && id <= groups.size() && groups[id - 1].live; }
+    const Group &group(int id) const { return groups[id - 1]; }
+
+    QVector<int> ids() const
+    {
+        QVector<int> out;
+        for (int i = 0; i < groups.size(); ++i) {
+            if (groups[i].live) out.append(i + 1);
+        }
+        return out;
+    }
+
+    qint64 time(int id, qint64 now) const
+    {
+        if (id == 0) return now;
+        const Group &g = groups[id - 1];
+        return g.paused ? g.frozen : time(g.parent, now) - g.offset;
+    }
+
+    // Годинник іде, лише якщо ні група, ні жоден її предок не на паузі
+    bool isRunning(int id) const
+    {
+        for (; id != 0; id = groups[id - 1].parent) {
+            if (groups[id - 1].paused) return false;
+        }
+        return true;
+    }
+
+    bool isAncestor(int ancestor, int id) const
+    {
+        for (; id != 0; id = groups[id - 1].parent) {
+            if (id == ancestor) return true;
+        }
+        return false;
+    }
+
+    bool pause(int id, qint64 now)
+    {
+        Group &g = groups[id - 1];
+        if (g.paused) return false;
+        g.frozen = time(id, now);
+        g.paused = true;
+        return true;
+    }
+
+    bool resume(int id, qint64 now)
+    {
+        Group &g = groups[id - 1];
+        if (!g.paused) return false;
+        g.paused = false;
+        g.offset = time(g.parent, now) - g.frozen;
+        return true;
+    }
+
+    // Додатний зсув переводить годинник групи вперед — її таймери спрацюють раніше
+    void shift(int id, qint64 delta)
+    {
+        Group &g = groups[id - 1];
+        if (g.paused) g.frozen += delta;
+        else g.offset -= delta;
+    }
+
+    void rename(int id, const QString &name) { groups[id - 1].name = name; }
+
+    // Зміна батька зберігає поточний час групи
+    void setParent(int id, int parent, qint64 now)
+    {
+        qint64 t = time(id, now);
+        groups[id - 1].parent = parent;
+        setTime(id, now, t);
+    }
+
+private:
+    QVector<Group> groups;  // id групи — індекс + 1
+
+    void setTime(int id, qint64 now, qint64 value)
+    {
+        Group &g = groups[id - 1];
+        if (g.paused) g.frozen = value;
+        else g.offset = time(g.parent, now) - value;
+    }
+};
+
+#endif // GROUPCLOCKS_H
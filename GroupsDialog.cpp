@@ -0,0 +1,264 @@
+#include "GroupsDialog.h"
+#include "TimerManager.h"
+#include "TimerTableModel.h"
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QInputDialog>
+#include <QMessageBox>
+#include <QHash>
+#include <QTreeWidgetItemIterator>
+#include <QVBoxLayout>
+
+GroupsDialog::GroupsDialog(TimerManager *manager, TimerTableModel *model, QWidget *parent)
+    : QDialog(parent), manager(manager), model(model)
+{
+    setWindowTitle("Групи таймерів");
+    resize(560, 420);
+
+    tree = new QTreeWidget(this);
+    tree->setColumnCount(3);
+    tree->setHeaderLabels({"Назва", "Час", "Стан"});
+    tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+
+    addGroupButton = new QPushButton("Нова група", this);
+    addSubgroupButton = new QPushButton("Підгрупа", this);
+    removeGroupButton = new QPushButton("Видалити групу", this);
+    pauseButton = new QPushButton("Пауза", this);
+    resumeButton = new QPushButton("Продовжити", this);
+    backButton = new QPushButton("−1 хв", this);
+    forwardButton = new QPushButton("+1 хв", this);
+    addCheckedButton = new QPushButton("Додати обрані таймери", this);
+    takeOutButton = new QPushButton("Вийняти з групи", this);
+
+    QHBoxLayout *groupLayout = new QHBoxLayout();
+    groupLayout->addWidget(addGroupButton);
+    groupLayout->addWidget(addSubgroupButton);
+    groupLayout->addWidget(removeGroupButton);
+    groupLayout->addStretch();
+
+    QHBoxLayout *clockLayout = new QHBoxLayout();
+    clockLayout->addWidget(pauseButton);
+    clockLayout->addWidget(resumeButton);
+    clockLayout->addWidget(backButton);
+    clockLayout->addWidget(forwardButton);
+    clockLayout->addStretch();
+
+    QHBoxLayout *memberLayout = new QHBoxLayout();
+    memberLayout->addWidget(addCheckedButton);
+    memberLayout->addWidget(takeOutButton);
+    memberLayout->addStretch();
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(tree);
+    mainLayout->addLayout(groupLayout);
+    mainLayout->addLayout(clockLayout);
+    mainLayout->addLayout(memberLayout);
+
+    connect(addGroupButton, &QPushButton::clicked, this, &GroupsDialog::onAddGroup);
+    connect(addSubgroupButton, &QPushButton::clicked, this, &GroupsDialog::onAddSubgroup);
+    connect(removeGroupButton, &QPushButton::clicked, this, &GroupsDialog::onRemoveGroup);
+    connect(pauseButton, &QPushButton::clicked, this, &GroupsDialog::onPause);
+    connect(resumeButton, &QPushButton::clicked, this, &GroupsDialog::onResume);
+    connect(backButton, &QPushButton::clicked, this, [this]() { onShift(-60 * 1000); });
+    connect(forwardButton, &QPushButton::clicked, this, [this]() { onShift(60 * 1000); });
+    connect(addCheckedButton, &QPushButton::clicked, this, &GroupsDialog::onAddChecked);
+    connect(takeOutButton, &QPushButton::clicked, this, &GroupsDialog::onTakeOut);
+
+    // Таймери групи додаються в дерево лише під час розгортання
+    connect(tree, &QTreeWidget::itemExpanded, this, &GroupsDialog::onItemExpanded);
+    connect(tree, &QTreeWidget::currentItemChanged, this, &GroupsDialog::updateButtons);
+    connect(manager, &TimerManager::groupsChanged, this, &GroupsDialog::rebuild);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(1000);
+    connect(refreshTimer, &QTimer::timeout, this, &GroupsDialog::refreshTimes);
+    refreshTimer->start();
+    rebuild();
+}
+
+void GroupsDialog::rebuild()
+{
+    // Розгорнуті групи і поточний рядок переживають перебудову
+    QSet<int> expanded;
+    for (QTreeWidgetItemIterator it(tree); *it; ++it) {
+        if ((*it)->isExpanded()) expanded.insert((*it)->data(0, GroupIdRole).toInt());
+    }
+    QTreeWidgetItem *current = tree->currentItem();
+    int currentGroupId = current ? current->data(0, GroupIdRole).toInt() : 0;
+    int currentTimerId = current ? current->data(0, TimerIdRole).toInt() : 0;
+
+    tree->clear();
+    filledItems.clear();
+
+    // Батьківська група завжди має менший id, тож створена раніше
+    QHash<int, QTreeWidgetItem*> items;
+    const GroupClocks &clocks = manager->groups();
+    for (int group : clocks.ids()) {
+        QTreeWidgetItem *parentItem = items.value(clocks.group(group).parent);
+        QTreeWidgetItem *item = parentItem ? new QTreeWidgetItem(parentItem) : new QTreeWidgetItem(tree);
+        item->setData(0, GroupIdRole, group);
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+        updateGroupItem(item);
+        items.insert(group, item);
+        if (group == currentGroupId && currentTimerId == 0) tree->setCurrentItem(item);
+    }
+
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+        if (expanded.contains(it.key())) it.value()->setExpanded(true);
+    }
+
+    if (currentTimerId != 0) {
+        for (QTreeWidgetItemIterator it(tree); *it; ++it) {
+            if ((*it)->data(0, TimerIdRole).toInt() == currentTimerId) tree->setCurrentItem(*it);
+        }
+    }
+    updateButtons();
+}
+
+void GroupsDialog::onItemExpanded(QTreeWidgetItem *item)
+{
+    fillMembers(item);
+}
+
+void GroupsDialog::fillMembers(QTreeWidgetItem *item)
+{
+    int group = item->data(0, GroupIdRole).toInt();
+    if (group == 0 || filledItems.contains(item)) return;
+    filledItems.insert(item);
+
+    for (int id : manager->timersInGroup(group)) {
+        QTreeWidgetItem *child = new QTreeWidgetItem(item);
+        child->setData(0, TimerIdRole, id);
+        updateTimerItem(child);
+    }
+}
+
+void GroupsDialog::refreshTimes()
+{
+    if (!isVisible()) return;
+    for (QTreeWidgetItemIterator it(tree); *it; ++it) {
+        if ((*it)->data(0, GroupIdRole).toInt() != 0) updateGroupItem(*it);
+        else updateTimerItem(*it);
+    }
+}
+
+void GroupsDialog::updateGroupItem(QTreeWidgetItem *item)
+{
+    int group = item->data(0, GroupIdRole).toInt();
+    const GroupClocks &clocks = manager->groups();
+    if (!clocks.contains(group)) return;
+    const GroupClocks::Group &g = clocks.group(group);
+
+    // Скільки годинник групи відстав від реального часу (або випередив його)
+    qint64 now = manager->storage().nowMs();
+    qint64 skew = clocks.time(group, now) - now;
+    QString time;
+    if (skew < 0) time = QString("−%1").arg(TimerTableModel::formatTime(TimerDuration(-skew)));
+    else if (skew > 0) time = QString("+%1").arg(TimerTableModel::formatTime(TimerDuration(skew)));
+
+    item->setText(0, g.name);
+    item->setText(1, time);
+    item->setText(2, g.paused ? QString("На паузі")
+                              : clocks.isRunning(group) ? QString("Іде") : QString("Стоїть з батьківською"));
+}
+
+void GroupsDialog::updateTimerItem(QTreeWidgetItem *item)
+{
+    TimerView t = manager->getTimerById(item->data(0, TimerIdRole).toInt());
+    if (!t) return;
+    item->setText(0, t.name());
+    item->setText(1, TimerTableModel::formatTime(t.remaining(), t.duration().count() % 1000 != 0));
+    item->setText(2, t.ticking() ? QString("Біжить") : t.running() ? QString("Група на паузі") : QString("Пауза"));
+}
+
+int GroupsDialog::currentGroup() const
+{
+    QTreeWidgetItem *item = tree->currentItem();
+    if (!item) return 0;
+    if (item->data(0, TimerIdRole).toInt() != 0) item = item->parent();
+    return item ? item->data(0, GroupIdRole).toInt() : 0;
+}
+
+void GroupsDialog::updateButtons()
+{
+    int group = currentGroup();
+    bool paused = group != 0 && manager->groups().group(group).paused;
+    QTreeWidgetItem *item = tree->currentItem();
+
+    addSubgroupButton->setEnabled(group != 0);
+    removeGroupButton->setEnabled(group != 0);
+    pauseButton->setEnabled(group != 0 && !paused);
+    resumeButton->setEnabled(paused);
+    backButton->setEnabled(group != 0);
+    forwardButton->setEnabled(group != 0);
+    addCheckedButton->setEnabled(group != 0);
+    takeOutButton->setEnabled(item && item->data(0, TimerIdRole).toInt() != 0);
+}
+
+void GroupsDialog::onAddGroup()
+{
+    QString name = QInputDialog::getText(this, "Нова група", "Назва групи:").trimmed();
+    if (!name.isEmpty()) manager->addGroup(name);
+}
+
+void GroupsDialog::onAddSubgroup()
+{
+    int parent = currentGroup();
+    if (parent == 0) return;
+    QString name = QInputDialog::getText(this, "Нова підгрупа", "Назва підгрупи:").trimmed();
+    if (!name.isEmpty()) manager->addGroup(name, parent);
+}
+
+void GroupsDialog::onRemoveGroup()
+{
+    int group = currentGroup();
+    if (group == 0) return;
+    if (QMessageBox::question(this, "Видалення групи",
+                              "Видалити групу? Її таймери і підгрупи перейдуть до батьківської групи.")
+        != QMessageBox::Yes)
+        return;
+    manager->removeGroup(group);
+}
+
+void GroupsDialog::onPause()
+{
+    manager->pauseGroup(currentGroup());
+}
+
+void GroupsDialog::onResume()
+{
+    manager->resumeGroup(currentGroup());
+}
+
+void GroupsDialog::onShift(qint64 deltaMs)
+{
+    manager->shiftGroup(currentGroup(), TimerDuration(deltaMs));
+}
+
+void GroupsDialog::onAddChecked()
+{
+    int group = currentGroup();
+    if (group == 0) return;
+
+    const QList<int> ids = model->checkedIds();
+    if (ids.isEmpty()) {
+        QMessageBox::information(this, "Групи", "Спочатку позначте таймери в таблиці");
+        return;
+    }
+
+    int skipped = 0;
+    for (int id : ids) {
+        if (!manager->setTimerGroup(id, group)) ++skipped;
+    }
+    if (skipped > 0)
+        QMessageBox::information(this, "Групи", QString("Таймери за розкладом не входять у групи: пропущено %1").arg(skipped));
+    rebuild();
+}
+
+void GroupsDialog::onTakeOut()
+{
+    QTreeWidgetItem *item = tree->currentItem();
+    if (!item) return;
+    int id = item->data(0, TimerIdRole).toInt();
+    if (id != 0 && manager->setTimerGroup(id, 0)) rebuild();
+}
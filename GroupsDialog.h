@@ -0,0 +1,62 @@
+#ifndef GROUPSDIALOG_H
+#define GROUPSDIALOG_H
+
+#include <QDialog>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QTimer>
+#include <QSet>
+
+class TimerManager;
+class TimerTableModel;
+
+// Групи таймерів деревом: вкладені групи згортаються разом з таймерами.
+// Пауза, продовження і зсув діють на годинник групи, а не на кожен таймер окремо
+class GroupsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    GroupsDialog(TimerManager *manager, TimerTableModel *model, QWidget *parent = nullptr);
+
+private slots:
+    void rebuild();
+    void refreshTimes();
+    void onItemExpanded(QTreeWidgetItem *item);
+    void onAddGroup();
+    void onAddSubgroup();
+    void onRemoveGroup();
+    void onPause();
+    void onResume();
+    void onShift(qint64 deltaMs);
+    void onAddChecked();
+    void onTakeOut();
+    void updateButtons();
+
+private:
+    enum ItemRole {
+        GroupIdRole = Qt::UserRole + 1,
+        TimerIdRole
+    };
+
+    TimerManager *manager;
+    TimerTableModel *model;
+    QTreeWidget *tree;
+    QPushButton *addGroupButton;
+    QPushButton *addSubgroupButton;
+    QPushButton *removeGroupButton;
+    QPushButton *pauseButton;
+    QPushButton *resumeButton;
+    QPushButton *backButton;
+    QPushButton *forwardButton;
+    QPushButton *addCheckedButton;
+    QPushButton *takeOutButton;
+    QTimer *refreshTimer;
+    QSet<QTreeWidgetItem*> filledItems;    // групи, чиї таймери вже додані в дерево
+
+    int currentGroup() const;
+    void fillMembers(QTreeWidgetItem *item);
+    void updateGroupItem(QTreeWidgetItem *item);
+    void updateTimerItem(QTreeWidgetItem *item);
+};
+
+#endif // GROUPSDIALOG_H
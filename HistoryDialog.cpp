@@ -0,0 +1,166 @@
+#include "HistoryDialog.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <functional>
+
+HistoryDialog::HistoryDialog(TimerHistory *history, QWidget *parent)
+    : QDialog(parent), history(history)
+{
+    setWindowTitle("Історія таймерів");
+    resize(640, 480);
+
+    rangeCombo = new QComboBox(this);
+    rangeCombo->addItem("Сьогодні", 1);
+    rangeCombo->addItem("7 днів", 7);
+    rangeCombo->addItem("30 днів", 30);
+    rangeCombo->addItem("90 днів", 90);
+    rangeCombo->addItem("Рік", 365);
+    rangeCombo->setCurrentIndex(1);
+
+    periodCombo = new QComboBox(this);
+    periodCombo->addItem("По днях", TimerHistory::Day);
+    periodCombo->addItem("По годинах", TimerHistory::Hour);
+
+    metricCombo = new QComboBox(this);
+    metricCombo->addItem("Час роботи");
+    metricCombo->addItem("Спрацювання");
+
+    timerTable = new QTableWidget(0, 2, this);
+    timerTable->setHorizontalHeaderLabels({"Таймер", "Усього"});
+    timerTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Stretch);
+    timerTable->verticalHeader()->setVisible(false);
+    timerTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    timerTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    timerTable->setSelectionMode(QAbstractItemView::SingleSelection);
+
+    seriesTable = new QTableWidget(0, 2, this);
+    seriesTable->setHorizontalHeaderLabels({"Період", "Значення"});
+    seriesTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    seriesTable->verticalHeader()->setVisible(false);
+    seriesTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    summaryLabel = new QLabel(this);
+    refreshButton = new QPushButton("Оновити", this);
+    closeButton = new QPushButton("Закрити", this);
+
+    QHBoxLayout *queryLayout = new QHBoxLayout();
+    queryLayout->addWidget(rangeCombo);
+    queryLayout->addWidget(periodCombo);
+    queryLayout->addWidget(metricCombo);
+    queryLayout->addStretch();
+
+    QHBoxLayout *tablesLayout = new QHBoxLayout();
+    tablesLayout->addWidget(timerTable);
+    tablesLayout->addWidget(seriesTable);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(refreshButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(closeButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addLayout(queryLayout);
+    mainLayout->addLayout(tablesLayout);
+    mainLayout->addWidget(summaryLabel);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(rangeCombo, &QComboBox::currentIndexChanged, this, &HistoryDialog::refresh);
+    connect(periodCombo, &QComboBox::currentIndexChanged, this, &HistoryDialog::refresh);
+    connect(metricCombo, &QComboBox::currentIndexChanged, this, &HistoryDialog::refresh);
+    connect(timerTable, &QTableWidget::itemSelectionChanged, this, &HistoryDialog::showSeries);
+    connect(refreshButton, &QPushButton::clicked, this, &HistoryDialog::refresh);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+
+    refresh();
+}
+
+QString HistoryDialog::formatValue(qint64 value) const
+{
+    if (!runTimeShown) return QString::number(value);
+    qint64 seconds = value / 1000;
+    return QString("%1:%2:%3")
+        .arg(seconds / 3600, 2, 10, QChar('0'))
+        .arg((seconds % 3600) / 60, 2, 10, QChar('0'))
+        .arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+void HistoryDialog::refresh()
+{
+    // Події, ще не скинуті на диск, історія читає з пам'яті, тож видно й останні секунди
+    QDate today = QDate::currentDate();
+    qint64 fromMs = today.addDays(1 - rangeCombo->currentData().toInt()).startOfDay().toMSecsSinceEpoch();
+    qint64 toMs = today.addDays(1).startOfDay().toMSecsSinceEpoch();
+    auto period = TimerHistory::Period(periodCombo->currentData().toInt());
+    runTimeShown = metricCombo->currentIndex() == 0;
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    result = runTimeShown ? history->runTime(fromMs, toMs, period) : history->expiries(fromMs, toMs, period);
+    qint64 queryMs = elapsed.elapsed();
+
+    // Найактивніші таймери за сумою; рядок "усі" першим
+    QVector<QPair<qint64, int>> totals;
+    totals.reserve(result.byTimer.size());
+    for (auto it = result.byTimer.cbegin(); it != result.byTimer.cend(); ++it) {
+        qint64 sum = 0;
+        for (qint64 v : it.value()) sum += v;
+        if (sum > 0) totals.append({sum, it.key()});
+    }
+    const int MaxTimers = 100;
+    int shown = qMin(int(totals.size()), MaxTimers);
+    std::partial_sort(totals.begin(), totals.begin() + shown, totals.end(), std::greater<QPair<qint64, int>>());
+
+    qint64 all = 0;
+    for (qint64 v : result.total) all += v;
+
+    timerTable->blockSignals(true);
+    timerTable->setRowCount(shown + 1);
+    auto setRow = [this](int row, const QString &name, qint64 value, int id) {
+        QTableWidgetItem *nameItem = new QTableWidgetItem(name);
+        nameItem->setData(TimerIdRole, id);
+        QTableWidgetItem *valueItem = new QTableWidgetItem(formatValue(value));
+        valueItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        timerTable->setItem(row, 0, nameItem);
+        timerTable->setItem(row, 1, valueItem);
+    };
+    setRow(0, "Усі таймери", all, 0);
+    for (int i = 0; i < shown; ++i) {
+        int id = totals[i].second;
+        QString name = history->nameOf(id);
+        setRow(i + 1, name.isEmpty() ? QString("#%1").arg(id) : name, totals[i].first, id);
+    }
+    timerTable->selectRow(0);
+    timerTable->blockSignals(false);
+    showSeries();
+
+    summaryLabel->setText(QString("Подій в історії: %1, на диску %2 КБ; запит прочитав %3 подій за %4 мс")
+                              .arg(history->eventCount())
+                              .arg(history->diskSize() / 1024)
+                              .arg(result.scannedEvents)
+                              .arg(queryMs));
+}
+
+// Порожні інтервали пропускаються — рік по годинах інакше дав би тисячі нульових рядків
+void HistoryDialog::showSeries()
+{
+    QTableWidgetItem *item = timerTable->item(timerTable->currentRow(), 0);
+    int id = item ? item->data(TimerIdRole).toInt() : 0;
+    const QVector<qint64> &values = id ? result.byTimer[id] : result.total;
+    bool hourly = periodCombo->currentData().toInt() == TimerHistory::Hour;
+
+    int rows = int(std::count_if(values.begin(), values.end(), [](qint64 v) { return v != 0; }));
+    seriesTable->setRowCount(rows);
+    int row = 0;
+    for (int i = 0; i < values.size(); ++i) {
+        if (values[i] == 0) continue;
+        QDateTime start = QDateTime::fromMSecsSinceEpoch(result.bucketStarts[i]);
+        seriesTable->setItem(row, 0, new QTableWidgetItem(start.toString(hourly ? "dd.MM.yyyy HH:00" : "dd.MM.yyyy")));
+        QTableWidgetItem *valueItem = new QTableWidgetItem(formatValue(values[i]));
+        valueItem->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        seriesTable->setItem(row++, 1, valueItem);
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef HISTORYDIALOG_H
+#define HISTORYDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QComboBox>
+#include <QLabel>
+#include <QPushButton>
+#include "TimerHistory.h"
+
+// Історія таймерів: час роботи або кількість спрацювань по днях чи годинах за обраний проміжок,
+// зверху — найактивніші таймери. Вибір таймера показує його ряд замість суми
+class HistoryDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit HistoryDialog(TimerHistory *history, QWidget *parent = nullptr);
+
+public slots:
+    void refresh();
+
+private slots:
+    void showSeries();
+
+private:
+    enum ItemRole {
+        TimerIdRole = Qt::UserRole + 1
+    };
+
+    TimerHistory *history;
+    QComboBox *rangeCombo;
+    QComboBox *periodCombo;
+    QComboBox *metricCombo;
+    QTableWidget *timerTable;
+    QTableWidget *seriesTable;
+    QLabel *summaryLabel;
+    QPushButton *refreshButton;
+    QPushButton *closeButton;
+
+    TimerHistory::Aggregate result;
+    bool runTimeShown = true;
+
+    QString formatValue(qint64 value) const;
+};
+
+#endif // HISTORYDIALOG_H
@@ -0,0 +1,83 @@
+#include "IpcProtocol.h"
+#include "TimerStorage.h"
+
+using namespace BinaryCodec;
+
+namespace Ipc {
+
+QByteArray frame(FrameType type, const QByteArray &body)
+{
+    QByteArray out;
+    out.reserve(5 + body.size());
+    put(out, quint32(body.size() + 1));
+    put(out, quint8(type));
+    out.append(body);
+    return out;
+}
+
+bool takeFrame(QByteArray &buffer, quint8 &type, QByteArray &body, bool *error)
+{
+    if (error) *error = false;
+    if (buffer.size() < 4) return false;
+
+    quint32 length = qFromLittleEndian<quint32>(buffer.constData());
+    if (length == 0 || length > MaxFrameSize) {
+        if (error) *error = true;
+        return false;
+    }
+    if (quint32(buffer.size()) < 4 + length) return false;
+
+    type = quint8(buffer[4]);
+    body = buffer.mid(5, int(length) - 1);
+    buffer.remove(0, int(4 + length));
+    return true;
+}
+
+StoredTimer recordOf(const TimerView &view, qint64 wallNow)
+{
+    StoredTimer t;
+    t.id = view.id();
+    t.name = view.name();
+    t.duration = view.duration();
+    t.remainingMs = view.remaining().count();
+    // Групи протоколом не передаються: таймер групи на паузі клієнт бачить призупиненим
+    t.wallDeadlineMs = view.ticking() ? wallNow + t.remainingMs : 0;
+    t.schedule = view.schedule();
+    return t;
+}
+
+StoredTimer recordOf(const TimerSnapshot &snapshot, const TimerRecord &record, qint64 now, qint64 wallNow)
+{
+    StoredTimer t;
+    t.id = record.id;
+    t.name = record.name;
+    t.duration = record.duration;
+    t.remainingMs = snapshot.remainingMs(record, now);
+    t.wallDeadlineMs = snapshot.isTicking(record) ? wallNow + t.remainingMs : 0;
+    t.schedule = record.schedule;
+    return t;
+}
+
+void putTimer(QByteArray &out, const StoredTimer &timer)
+{
+    put(out, qint32(timer.id));
+    putString(out, timer.name);
+    put(out, qint64(timer.duration.count()));
+    put(out, qint64(timer.remainingMs));
+    put(out, qint64(timer.wallDeadlineMs));
+    putSchedule(out, timer.schedule);
+}
+
+bool getTimer(Reader &r, StoredTimer &timer)
+{
+    qint32 id;
+    qint64 duration;
+    if (!r.get(id) || !r.getString(timer.name) || !r.get(duration) || !r.get(timer.remainingMs)
+        || !r.get(timer.wallDeadlineMs) || !r.getSchedule(timer.schedule))
+        return false;
+    timer.id = id;
+    timer.duration = TimerDuration(duration);
+    return true;
+}
+
+} // namespace Ipc
@@ -0,0 +1,97 @@
+#ifndef IPCPROTOCOL_H
+#define IPCPROTOCOL_H
+
+#include <QByteArray>
+#include <QVector>
+#include "TimerStore.h"
+#include "BinaryCodec.h"
+#include "TimerSnapshot.h"
+
+class TimerView;
+
+// Двійковий протокол керування таймерами через QLocalServer (Unix-сокет / іменований канал).
+//
+// Кадр:    quint32 довжина (байти після цього поля) | quint8 тип кадру | тіло
+// Усі числа little-endian, рядки — quint16 довжина + UTF-16 (див. BinaryCodec.h).
+//
+// Запит (FrameRequest):   quint32 seq | quint32 кількість | команди...
+//   Add          рядок назва | qint64 тривалість_мс | розклад
+//   Start/Pause/Remove/Reset   qint32 id
+//   Update       qint32 id | рядок назва | qint64 тривалість_мс
+//   SetSchedule  qint32 id | розклад
+//   Query        qint32 id
+//   QueryAll     —
+//   Subscribe    quint8 маска подій (SubscribeFinished | SubscribeChanges), 0 — відписатися
+// розклад: quint8 вид (TimerSchedule::Kind) | рядок вираз cron
+//
+// Відповідь (FrameReply): quint32 seq | quint32 кількість | на кожну команду:
+//   quint8 команда | qint32 статус (id для Add, 1/0 — успіх, для QueryAll — кількість записів) | записи
+//   Записи йдуть після Query (якщо статус 1) і QueryAll.
+//
+// Події (FrameEvents): quint32 кількість | quint8 тип події | запис (для Removed — лише qint32 id)
+//
+// Запис таймера: qint32 id | рядок назва | qint64 тривалість_мс | qint64 залишок_мс |
+//                qint64 дедлайн за настінним годинником (0 — на паузі) | розклад
+//
+// Один запит може містити тисячі команд; послідовні Start/Pause/Remove/Reset виконуються однією пакетною операцією.
+namespace Ipc {
+
+enum FrameType : quint8 {
+    FrameRequest = 1,
+    FrameReply,
+    FrameEvents
+};
+
+enum Command : quint8 {
+    CmdAdd = 1,
+    CmdStart,
+    CmdPause,
+    CmdRemove,
+    CmdReset,
+    CmdUpdate,
+    CmdSetSchedule,
+    CmdQuery,
+    CmdQueryAll,
+    CmdSubscribe
+};
+
+enum EventType : quint8 {
+    EventAdded = 1,
+    EventUpdated,
+    EventFinished,
+    EventRemoved
+};
+
+enum SubscribeMask : quint8 {
+    SubscribeFinished = 0x01,
+    SubscribeChanges = 0x02     // додавання, зміни стану, видалення
+};
+
+const quint32 MaxFrameSize = 64 * 1024 * 1024;
+
+struct Result {
+    quint8 command = 0;
+    qint32 status = 0;
+    QVector<StoredTimer> timers;
+};
+
+struct Event {
+    quint8 type = 0;
+    StoredTimer timer;          // для Removed і Finished заповнено лише id (Finished — ще й стан)
+};
+
+// Загортає тіло в кадр
+QByteArray frame(FrameType type, const QByteArray &body);
+// Виймає з буфера один повний кадр; false — якщо кадр ще не дочитано. Некоректна довжина — error
+bool takeFrame(QByteArray &buffer, quint8 &type, QByteArray &body, bool *error = nullptr);
+
+// Знімок стану таймера для передачі; дедлайн — за настінним годинником менеджера-відправника (wallNow)
+StoredTimer recordOf(const TimerView &view, qint64 wallNow);
+StoredTimer recordOf(const TimerSnapshot &snapshot, const TimerRecord &record, qint64 now, qint64 wallNow);
+
+void putTimer(QByteArray &out, const StoredTimer &timer);
+bool getTimer(BinaryCodec::Reader &r, StoredTimer &timer);
+
+} // namespace Ipc
+
+#endif // IPCPROTOCOL_H
@@ -0,0 +1,105 @@
+#ifndef NAMEFINGERPRINTS_H
+#define NAMEFINGERPRINTS_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Хеш назв для компактного режиму: лише 32-бітний відбиток назви й id, 8 байт на комірку, відкрита адресація.
+// Відбитки різних назв можуть збігтися, тож кожного кандидата перевіряють порівнянням самої назви
+class NameFingerprints
+{
+public:
+    static quint32 fingerprint(const QString &name)
+    {
+        size_t h = qHash(name);
+        return quint32(h) ^ quint32(quint64(h) >> 32);
+    }
+
+    void insert(const QString &name, int id)
+    {
+        if ((used + 1) * 10 > table.size() * 7) rehash(qMax(16, int(table.size()) * (live * 2 >= used ? 2 : 1)));
+        quint32 fp = fingerprint(name);
+        int mask = table.size() - 1;
+        int i = int(fp) & mask;
+        while (table[i].id > 0) i = (i + 1) & mask;
+        if (table[i].id == Empty) ++used;
+        table[i] = {fp, id};
+        ++live;
+    }
+
+    void remove(const QString &name, int id)
+    {
+        if (table.isEmpty()) return;
+        quint32 fp = fingerprint(name);
+        int mask = table.size() - 1;
+        for (int i = int(fp) & mask; table[i].id != Empty; i = (i + 1) & mask) {
+            if (table[i].id == id && table[i].fp == fp) {
+                table[i].id = Removed;
+                --live;
+                return;
+            }
+        }
+    }
+
+    // Чи є id з таким самим відбитком, для якого match(id) істинне
+    template <typename F>
+    bool any(const QString &name, F match) const
+    {
+        if (table.isEmpty()) return false;
+        quint32 fp = fingerprint(name);
+        int mask = table.size() - 1;
+        for (int i = int(fp) & mask; table[i].id != Empty; i = (i + 1) & mask) {
+            if (table[i].id > 0 && table[i].fp == fp && match(table[i].id)) return true;
+        }
+        return false;
+    }
+
+    void reserve(int count)
+    {
+        int capacity = 16;
+        while (capacity * 7 < count * 10) capacity *= 2;
+        if (capacity > table.size()) rehash(capacity);
+    }
+
+    void clear()
+    {
+        table.clear();
+        used = live = 0;
+    }
+
+    qint64 memoryBytes() const { return table.capacity() * qint64(sizeof(Cell)); }
+
+private:
+    enum : int { Empty = 0, Removed = -1 };    // id таймерів додатні
+
+    struct Cell {
+        quint32 fp;
+        int id;
+    };
+
+    QVector<Cell> table;    // розмір — степінь двійки
+    int used = 0;           // живі й видалені комірки
+    int live = 0;
+
+    // Видалені комірки при перехешуванні зникають
+    void rehash(int capacity)
+    {
+        QVector<Cell> old;
+        old.swap(table);
+        table.fill(Cell{0, Empty}, capacity);
+        used = live = 0;
+        int mask = capacity - 1;
+        for (const Cell &c : old) {
+            if (c.id <= 0) continue;
+            int i = int(c.fp) & mask;
+            while (table[i].id != Empty) i = (i + 1) & mask;
+            table[i] = c;
+            ++used;
+            ++live;
+        }
+    }
+};
+
+#endif // NAMEFINGERPRINTS_H
@@ -0,0 +1,76 @@
+#include "NameIndex.h"
+#include <algorithm>
+
+quint64 NameIndex::gramKey(const QString &folded, int pos, int len)
+{
+    quint64 key = quint64(len) << 48;
+    for (int i = 0; i < len; ++i) key |= quint64(folded.at(pos + i).unicode()) << (16 * i);
+    return key;
+}
+
+QVector<quint64> NameIndex::gramsOf(const QString &name)
+{
+    QString folded = name.toCaseFolded();
+    QVector<quint64> grams;
+    grams.reserve(folded.size() * MaxGram);
+    for (int pos = 0; pos < folded.size(); ++pos) {
+        for (int len = 1; len <= MaxGram && pos + len <= folded.size(); ++len)
+            grams.append(gramKey(folded, pos, len));
+    }
+
+    // Повторювані n-грами однієї назви індексуються один раз
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+void NameIndex::insert(int id, const QString &name)
+{
+    for (quint64 gram : gramsOf(name)) postings[gram].insert(id);
+}
+
+void NameIndex::remove(int id, const QString &name)
+{
+    for (quint64 gram : gramsOf(name)) {
+        auto it = postings.find(gram);
+        if (it == postings.end()) continue;
+        it->remove(id);
+        if (it->isEmpty()) postings.erase(it);
+    }
+}
+
+QVector<int> NameIndex::candidates(const QString &query, bool *exact) const
+{
+    QString folded = query.toCaseFolded();
+    if (exact) *exact = folded.size() <= MaxGram;
+    if (folded.isEmpty()) return {};
+
+    if (folded.size() <= MaxGram) {
+        const QSet<int> ids = postings.value(gramKey(folded, 0, folded.size()));
+        return QVector<int>(ids.begin(), ids.end());
+    }
+
+    // Списки триграм запиту від найкоротшого; відсутня триграма — збігів немає
+    QVector<const QSet<int>*> lists;
+    for (int pos = 0; pos + MaxGram <= folded.size(); ++pos) {
+        auto it = postings.constFind(gramKey(folded, pos, MaxGram));
+        if (it == postings.constEnd()) return {};
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QSet<int> *a, const QSet<int> *b) { return a->size() < b->size(); });
+
+    QVector<int> out;
+    for (int id : *lists.first()) {
+        bool all = true;
+        for (int i = 1; i < lists.size() && all; ++i) all = lists[i]->contains(id);
+        if (all) out.append(id);
+    }
+    return out;
+}
+
+qint64 NameIndex::memoryBytes() const
+{
+    qint64 bytes = postings.capacity() * qint64(sizeof(quint64) + sizeof(QSet<int>) + 1);
+    for (const QSet<int> &ids : postings) bytes += ids.capacity() * qint64(sizeof(int) + 1);
+    return bytes;
+}
@@ -0,0 +1,37 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+// Індекс n-грам назв таймерів (1–3 символи, без урахування регістру) для пошуку за підрядком.
+// Запит до 3 символів — це одна n-грама, тож її список і є відповіддю.
+// Довший запит перетинає списки своїх триграм, починаючи з найкоротшого; кандидатів треба ще перевірити.
+class NameIndex
+{
+public:
+    void insert(int id, const QString &name);
+    void remove(int id, const QString &name);
+    void clear() { postings.clear(); }
+    qint64 memoryBytes() const;
+
+    // exact — чи всі повернуті id гарантовано містять запит (інакше потрібна перевірка назви)
+    QVector<int> candidates(const QString &query, bool *exact = nullptr) const;
+
+    static bool matches(const QString &name, const QString &query)
+    {
+        return name.contains(query, Qt::CaseInsensitive);
+    }
+
+private:
+    static constexpr int MaxGram = 3;
+
+    QHash<quint64, QSet<int>> postings;
+
+    static quint64 gramKey(const QString &folded, int pos, int len);
+    static QVector<quint64> gramsOf(const QString &name);
+};
+
+#endif // NAMEINDEX_H
@@ -0,0 +1,161 @@
+#ifndef PERSISTENTVECTOR_H
+#define PERSISTENTVECTOR_H
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <memory>
+
+// Персистентний вектор: 32-арне дерево зі спільними вузлами.
+// Копія — O(1) і більше ніколи не змінюється; set() копіює лише шлях від кореня до листа (O(log32 n)).
+// Кожен вузол позначений міткою правки вектора, що його створив; на місці змінюються лише вузли з поточною
+// міткою, а копіювання видає новими мітки обом векторам. Тож вузли, створені після останньої копії,
+// змінюються на місці — серія змін між копіями майже безкоштовна, — а досяжні з будь-якої копії лише
+// копіюються. Лічильники посилань не перевіряються: їх змінюють інші потоки, що відпускають свої копії.
+// Читати копію можна з будь-якого потоку; змінювати вектор — лише з одного
+template <typename T>
+class PersistentVector
+{
+public:
+    PersistentVector() = default;
+
+    PersistentVector(const PersistentVector &other)
+        : root(other.root), shift(other.shift), count(other.count)
+    {
+        other.seal();
+    }
+
+    PersistentVector(PersistentVector &&other) noexcept
+        : root(std::move(other.root)), shift(other.shift), count(other.count), edit(other.edit.load())
+    {
+        other.shift = other.count = 0;
+        other.seal();
+    }
+
+    PersistentVector &operator=(const PersistentVector &other)
+    {
+        if (this == &other) return *this;
+        other.seal();
+        root = other.root;
+        shift = other.shift;
+        count = other.count;
+        seal();
+        return *this;
+    }
+
+    PersistentVector &operator=(PersistentVector &&other) noexcept
+    {
+        if (this == &other) return *this;
+        root = std::move(other.root);
+        shift = other.shift;
+        count = other.count;
+        edit = other.edit.load();
+        other.shift = other.count = 0;
+        other.seal();
+        return *this;
+    }
+
+    int size() const { return count; }
+
+    // Ще не записані елементи читаються як T()
+    const T &at(int i) const
+    {
+        const Node *node = root.get();
+        for (int level = shift; node && level > 0; level -= Bits)
+            node = static_cast<const Inner*>(node)->child[(i >> level) & Mask].get();
+        return node ? static_cast<const Leaf*>(node)->value[i & Mask] : empty();
+    }
+
+    void resize(int n)
+    {
+        while (n > (qint64(Width) << shift)) {
+            if (root) {
+                auto inner = std::make_shared<Inner>();
+                inner->owner = edit;
+                inner->child[0] = std::move(root);
+                root = std::move(inner);
+            }
+            shift += Bits;
+        }
+        count = n;
+    }
+
+    void set(int i, const T &value)
+    {
+        Q_ASSERT(i >= 0 && i < count);
+        setIn(root, shift, i, value);
+    }
+
+    // Обхід записаних листів у порядку індексів; порожні піддерева пропускаються цілком
+    template <typename F>
+    void forEach(F f) const { forEachIn(root.get(), shift, 0, f); }
+
+private:
+    static constexpr int Bits = 5;
+    static constexpr int Width = 1 << Bits;
+    static constexpr int Mask = Width - 1;
+
+    struct Node {
+        virtual ~Node() = default;
+        quint64 owner = 0;  // мітка правки, якою вузол створено
+    };
+    struct Inner : Node { std::array<std::shared_ptr<Node>, Width> child; };
+    struct Leaf : Node { std::array<T, Width> value; };
+
+    std::shared_ptr<Node> root;
+    int shift = 0;      // Bits * (висота дерева - 1)
+    int count = 0;
+    // Атомарна, бо копіювати вектор (і так міняти мітку) можуть з будь-якого потоку
+    mutable std::atomic<quint64> edit{newEdit()};
+
+    static quint64 newEdit()
+    {
+        static std::atomic<quint64> last{0};
+        return ++last;
+    }
+
+    // Усі наявні вузли стають спільними з копією
+    void seal() const { edit.store(newEdit(), std::memory_order_relaxed); }
+
+    static const T &empty()
+    {
+        static const T value{};
+        return value;
+    }
+
+    // Вузол з чужою міткою (можливо, досяжний з копії) спершу копіюється; створений цією правкою змінюється на місці
+    void setIn(std::shared_ptr<Node> &node, int level, int i, const T &value)
+    {
+        quint64 current = edit.load(std::memory_order_relaxed);
+        if (level == 0) {
+            if (!node) node = std::make_shared<Leaf>();
+            else if (node->owner != current) node = std::make_shared<Leaf>(*static_cast<const Leaf*>(node.get()));
+            node->owner = current;
+            static_cast<Leaf*>(node.get())->value[i & Mask] = value;
+            return;
+        }
+        if (!node) node = std::make_shared<Inner>();
+        else if (node->owner != current) node = std::make_shared<Inner>(*static_cast<const Inner*>(node.get()));
+        node->owner = current;
+        setIn(static_cast<Inner*>(node.get())->child[(i >> level) & Mask], level - Bits, i, value);
+    }
+
+    template <typename F>
+    void forEachIn(const Node *node, int level, int base, F &f) const
+    {
+        if (!node) return;
+        if (level == 0) {
+            const Leaf *leaf = static_cast<const Leaf*>(node);
+            for (int j = 0; j < Width && base + j < count; ++j) f(base + j, leaf->value[j]);
+            return;
+        }
+        const Inner *inner = static_cast<const Inner*>(node);
+        for (int j = 0; j < Width; ++j) {
+            int childBase = base + (j << level);
+            if (childBase >= count) break;
+            forEachIn(inner->child[j].get(), level - Bits, childBase, f);
+        }
+    }
+};
+
+#endif // PERSISTENTVECTOR_H
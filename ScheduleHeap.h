@@ -0,0 +1,91 @@
+#ifndef SCHEDULEHEAP_H
+#define SCHEDULEHEAP_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Бінарна купа дедлайнів за настінним годинником для таймерів за розкладом.
+// Вставка, видалення довільного слоту і взяття найближчого — O(log n); позиції відстежуються за слотом.
+class ScheduleHeap
+{
+public:
+    bool isEmpty() const { return heap.isEmpty(); }
+    int size() const { return heap.size(); }
+    qint64 memoryBytes() const
+    {
+        return heap.capacity() * qint64(sizeof(Entry)) + positions.capacity() * qint64(sizeof(int));
+    }
+    bool contains(int slot) const { return slot < positions.size() && positions[slot] >= 0; }
+
+    qint64 topKey() const { return heap.first().key; }
+    int topSlot() const { return heap.first().slot; }
+
+    void push(int slot, qint64 key)
+    {
+        if (slot >= positions.size()) positions.resize(slot + 1, -1);
+        if (positions[slot] >= 0) remove(slot);
+        heap.append(Entry{key, slot});
+        positions[slot] = heap.size() - 1;
+        siftUp(heap.size() - 1);
+    }
+
+    void pop() { removeAt(0); }
+
+    void remove(int slot)
+    {
+        if (contains(slot)) removeAt(positions[slot]);
+    }
+
+private:
+    struct Entry {
+        qint64 key;
+        int slot;
+    };
+
+    QVector<Entry> heap;
+    QVector<int> positions;     // індекс у heap за слотом; -1 — слоту в купі немає
+
+    void removeAt(int i)
+    {
+        positions[heap[i].slot] = -1;
+        Entry last = heap.takeLast();
+        if (i == heap.size()) return;
+        heap[i] = last;
+        positions[last.slot] = i;
+        siftUp(i);
+        siftDown(positions[last.slot]);
+    }
+
+    void siftUp(int i)
+    {
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (heap[parent].key <= heap[i].key) break;
+            swapEntries(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown(int i)
+    {
+        const int n = heap.size();
+        for (;;) {
+            int smallest = i;
+            int l = 2 * i + 1, r = l + 1;
+            if (l < n && heap[l].key < heap[smallest].key) smallest = l;
+            if (r < n && heap[r].key < heap[smallest].key) smallest = r;
+            if (smallest == i) return;
+            swapEntries(i, smallest);
+            i = smallest;
+        }
+    }
+
+    void swapEntries(int a, int b)
+    {
+        qSwap(heap[a], heap[b]);
+        positions[heap[a].slot] = a;
+        positions[heap[b].slot] = b;
+    }
+};
+
+#endif // SCHEDULEHEAP_H
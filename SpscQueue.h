@@ -0,0 +1,66 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Безблокувальна кільцева черга на одного виробника і одного споживача.
+// Ємність — степінь двійки; push() повертає false, якщо черга заповнена.
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(int capacity = 1 << 16)
+        : buffer(new T[size_t(capacity)]()), mask(size_t(capacity) - 1)
+    {
+        Q_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+    }
+
+    // Лише з потоку виробника
+    bool push(const T &value)
+    {
+        const size_t head = headPos.load(std::memory_order_relaxed);
+        if (head - tailCache > mask) {
+            tailCache = tailPos.load(std::memory_order_acquire);
+            if (head - tailCache > mask) return false;
+        }
+        buffer[head & mask] = value;
+        headPos.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Лише з потоку споживача
+    bool pop(T &value)
+    {
+        const size_t tail = tailPos.load(std::memory_order_relaxed);
+        if (tail == headCache) {
+            headCache = headPos.load(std::memory_order_acquire);
+            if (tail == headCache) return false;
+        }
+        value = buffer[tail & mask];
+        tailPos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Приблизна кількість елементів (точна лише з одного з двох потоків)
+    size_t sizeApprox() const
+    {
+        return headPos.load(std::memory_order_acquire) - tailPos.load(std::memory_order_acquire);
+    }
+
+private:
+    // Не QVector: неконстантний operator[] перевіряє лічильник посилань і може від'єднати копію, а його
+    // викликають обидва потоки. Тут доступ — лише до окремих комірок
+    const std::unique_ptr<T[]> buffer;
+    const size_t mask;
+
+    // Індекси виробника і споживача в окремих кеш-лініях, щоб потоки не заважали один одному
+    alignas(64) std::atomic<size_t> headPos{0};
+    size_t tailCache = 0;
+    alignas(64) std::atomic<size_t> tailPos{0};
+    size_t headCache = 0;
+};
+
+#endif // SPSCQUEUE_H
@@ -0,0 +1,124 @@
+#include "StatsDialog.h"
+#include "TimerStats.h"
+#include "TimerManager.h"
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QVBoxLayout>
+
+StatsDialog::StatsDialog(TimerManager *manager, QWidget *parent)
+    : QDialog(parent), manager(manager), stats(&manager->stats())
+{
+    setWindowTitle("Статистика таймерів");
+    resize(640, 260);
+
+    histogramTable = new QTableWidget(3, 7, this);
+    histogramTable->setHorizontalHeaderLabels({"Кількість", "p50", "p90", "p99", "p99.9", "Макс", "Середнє"});
+    histogramTable->setVerticalHeaderLabels({"Запізнення спрацювання, мкс", "Обробка тіку, мкс", "Сигнал → малювання, мкс"});
+    histogramTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    histogramTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    ratesLabel = new QLabel(this);
+    memoryLabel = new QLabel(this);
+    actionsLabel = new QLabel(this);
+
+    saveButton = new QPushButton("Зберегти JSON", this);
+    resetButton = new QPushButton("Скинути", this);
+    closeButton = new QPushButton("Закрити", this);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(saveButton);
+    buttonLayout->addWidget(resetButton);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(closeButton);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->addWidget(histogramTable);
+    mainLayout->addWidget(ratesLabel);
+    mainLayout->addWidget(actionsLabel);
+    mainLayout->addWidget(memoryLabel);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(saveButton, &QPushButton::clicked, this, &StatsDialog::onSaveJson);
+    connect(resetButton, &QPushButton::clicked, this, &StatsDialog::onReset);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(1000);
+    connect(refreshTimer, &QTimer::timeout, this, &StatsDialog::refresh);
+    refreshTimer->start();
+    refresh();
+}
+
+void StatsDialog::refresh()
+{
+    const LatencyHistogram *rows[] = {&stats->expiryLateness, &stats->tickProcessing, &stats->signalToPaint};
+
+    for (int row = 0; row < 3; ++row) {
+        const LatencyHistogram *h = rows[row];
+        const QString cells[] = {
+            QString::number(h->count()),
+            QString::number(h->percentile(50)),
+            QString::number(h->percentile(90)),
+            QString::number(h->percentile(99)),
+            QString::number(h->percentile(99.9)),
+            QString::number(h->max()),
+            QString::number(h->mean(), 'f', 1),
+        };
+        for (int col = 0; col < 7; ++col) {
+            QTableWidgetItem *item = histogramTable->item(row, col);
+            if (!item) {
+                item = new QTableWidgetItem();
+                item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+                histogramTable->setItem(row, col, item);
+            }
+            item->setText(cells[col]);
+        }
+    }
+
+    // Без лічильника виділень (SMARTTIMER_COUNT_ALLOCATIONS) їх кількість невідома, а не нульова
+    QString rates = QString("За секунду: спрацювань %1, перемальовувань %2")
+                        .arg(stats->expirationsPerSecond())
+                        .arg(stats->repaintsPerSecond());
+#ifdef SMARTTIMER_COUNT_ALLOCATIONS
+    rates += QString(", виділень пам'яті %1").arg(stats->allocationsPerSecond());
+#endif
+    ratesLabel->setText(rates);
+
+    const ActionDispatcher &actions = manager->actionDispatcher();
+    actionsLabel->setText(QString("Дії: у черзі %1 з %2, виконується %3, виконано %4, з помилкою %5, відкинуто %6; "
+                                  "очікування p50 %7 мкс, p99 %8 мкс")
+                              .arg(actions.queueDepth())
+                              .arg(actions.queueCapacity())
+                              .arg(actions.running())
+                              .arg(actions.completed())
+                              .arg(actions.failed())
+                              .arg(actions.dropped())
+                              .arg(actions.queueLatency.percentile(50))
+                              .arg(actions.queueLatency.percentile(99)));
+
+    TimerManager::MemoryUsage memory = manager->memoryUsage();
+    memoryLabel->setText(QString("Пам'ять%1: %2 КБ (сховище %3, індекси %4, планування %5), %6 байт на таймер")
+                             .arg(manager->isCompactMode() ? QString(" (компактний режим)") : QString())
+                             .arg(memory.total() / 1024)
+                             .arg(memory.storage / 1024)
+                             .arg(memory.indexes / 1024)
+                             .arg(memory.scheduling / 1024)
+                             .arg(memory.bytesPerTimer(), 0, 'f', 1));
+}
+
+void StatsDialog::onSaveJson()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Зберегти статистику", "timer-stats.json", "JSON (*.json)");
+    if (path.isEmpty()) return;
+
+    if (!stats->dumpToFile(path))
+        QMessageBox::warning(this, "Помилка", "Не вдалося записати файл");
+}
+
+void StatsDialog::onReset()
+{
+    stats->reset();
+    refresh();
+}
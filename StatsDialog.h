@@ -0,0 +1,39 @@
+#ifndef STATSDIALOG_H
+#define STATSDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+
+class TimerStats;
+class TimerManager;
+
+// Панель статистики таймерів: перцентилі гістограм, лічильники за секунду, черга дій і пам'ять;
+// оновлюється щосекунди
+class StatsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    explicit StatsDialog(TimerManager *manager, QWidget *parent = nullptr);
+
+private slots:
+    void refresh();
+    void onSaveJson();
+    void onReset();
+
+private:
+    TimerManager *manager;
+    TimerStats *stats;
+    QTableWidget *histogramTable;
+    QLabel *ratesLabel;
+    QLabel *memoryLabel;
+    QLabel *actionsLabel;
+    QPushButton *saveButton;
+    QPushButton *resetButton;
+    QPushButton *closeButton;
+    QTimer *refreshTimer;
+};
+
+#endif // STATSDIALOG_H
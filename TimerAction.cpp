@@ -0,0 +1,71 @@
+#include "TimerAction.h"
+#include <QStringList>
+
+namespace {
+
+struct KindName {
+    TimerAction::Kind kind;
+    const char *name;
+    const char *alias;
+};
+
+const KindName kindNames[] = {
+    {TimerAction::Sound, "звук", "sound"},
+    {TimerAction::Command, "команда", "run"},
+    {TimerAction::Log, "журнал", "log"},
+    {TimerAction::Notify, "сповіщення", "notify"},
+};
+
+} // namespace
+
+QString TimerAction::toString() const
+{
+    for (const KindName &k : kindNames) {
+        if (k.kind != kind) continue;
+        QString name = QString::fromUtf8(k.name);
+        return argument.isEmpty() ? name : QString("%1: %2").arg(name, argument);
+    }
+    return QString();
+}
+
+QVector<TimerAction> TimerAction::parseList(const QString &text, QString *error)
+{
+    QVector<TimerAction> actions;
+    const QStringList lines = text.split('\n');
+    for (int i = 0; i < lines.size(); ++i) {
+        QString line = lines[i].trimmed();
+        if (line.isEmpty()) continue;
+
+        int colon = line.indexOf(':');
+        QString name = (colon < 0 ? line : line.left(colon)).trimmed().toLower();
+        QString argument = colon < 0 ? QString() : line.mid(colon + 1).trimmed();
+
+        bool known = false;
+        TimerAction action;
+        for (const KindName &k : kindNames) {
+            if (name == QString::fromUtf8(k.name) || name == QLatin1String(k.alias)) {
+                action.kind = k.kind;
+                known = true;
+                break;
+            }
+        }
+        if (!known) {
+            if (error) *error = QString("Рядок %1: невідома дія \"%2\"").arg(i + 1).arg(name);
+            return {};
+        }
+        if (argument.isEmpty() && action.kind != Sound) {
+            if (error) *error = QString("Рядок %1: для дії \"%2\" потрібен параметр після двокрапки").arg(i + 1).arg(name);
+            return {};
+        }
+        action.argument = argument;
+        actions.append(action);
+    }
+    return actions;
+}
+
+QString TimerAction::formatList(const QVector<TimerAction> &actions)
+{
+    QStringList lines;
+    for (const TimerAction &action : actions) lines.append(action.toString());
+    return lines.join('\n');
+}
@@ -0,0 +1,32 @@
+#ifndef TIMERACTION_H
+#define TIMERACTION_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// Дія, що виконується, коли таймер спрацьовує. Дії одного таймера виконуються по черзі, у порядку списку.
+// Текстовий вигляд — по одній дії на рядок: "звук: файл", "команда: рядок оболонки",
+// "журнал: файл", "сповіщення: текст" (також sound:, run:, log:, notify:)
+struct TimerAction
+{
+    enum Kind : quint8 {
+        Sound,      // звуковий сигнал; файл — необов'язковий, відтворює його застосунок
+        Command,    // команда оболонки у фоновому потоці; TIMER_ID і TIMER_NAME — у змінних оточення
+        Log,        // рядок у файлі журналу
+        Notify      // сповіщення у вікні застосунку
+    };
+
+    Kind kind = Sound;
+    QString argument;
+
+    bool operator==(const TimerAction &o) const { return kind == o.kind && argument == o.argument; }
+
+    QString toString() const;
+
+    // Порожні рядки пропускаються; при помилці повертає порожній список і пише її в error
+    static QVector<TimerAction> parseList(const QString &text, QString *error = nullptr);
+    static QString formatList(const QVector<TimerAction> &actions);
+};
+
+#endif // TIMERACTION_H
@@ -0,0 +1,76 @@
+#include "TimerActionsDelegate.h"
+#include "TimerTableModel.h"
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPainter>
+
+TimerActionsDelegate::TimerActionsDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+QRect TimerActionsDelegate::toggleRect(const QRect &cell)
+{
+    QRect r = cell.adjusted(2, 2, -2, -2);
+    r.setWidth(r.width() / 2 - 1);
+    return r;
+}
+
+QRect TimerActionsDelegate::deleteRect(const QRect &cell)
+{
+    QRect r = cell.adjusted(2, 2, -2, -2);
+    r.setLeft(r.left() + r.width() / 2 + 1);
+    return r;
+}
+
+void TimerActionsDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem opt(option);
+    initStyleOption(&opt, index);
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+
+    // Фон клітинки (виділення, чергування рядків)
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    QStyleOptionButton button;
+    button.state = QStyle::State_Enabled | QStyle::State_Raised;
+    button.fontMetrics = option.fontMetrics;
+
+    button.rect = toggleRect(option.rect);
+    button.text = "Старт/Стоп";
+    style->drawControl(QStyle::CE_PushButton, &button, painter, widget);
+
+    button.rect = deleteRect(option.rect);
+    button.text = "Видалити";
+    style->drawControl(QStyle::CE_PushButton, &button, painter, widget);
+}
+
+QSize TimerActionsDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &) const
+{
+    int w = option.fontMetrics.horizontalAdvance("Старт/Стоп") + option.fontMetrics.horizontalAdvance("Видалити");
+    return QSize(w + 40, option.fontMetrics.height() + 12);
+}
+
+bool TimerActionsDelegate::editorEvent(QEvent *event, QAbstractItemModel *model,
+                                       const QStyleOptionViewItem &option, const QModelIndex &index)
+{
+    if (event->type() != QEvent::MouseButtonRelease)
+        return QStyledItemDelegate::editorEvent(event, model, option, index);
+
+    QMouseEvent *mouse = static_cast<QMouseEvent*>(event);
+    if (mouse->button() != Qt::LeftButton)
+        return false;
+
+    int id = index.data(TimerTableModel::TimerIdRole).toInt();
+    QPoint pos = mouse->position().toPoint();
+    if (toggleRect(option.rect).contains(pos)) {
+        emit toggleClicked(id);
+        return true;
+    }
+    if (deleteRect(option.rect).contains(pos)) {
+        emit deleteClicked(id);
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,28 @@
+#ifndef TIMERACTIONSDELEGATE_H
+#define TIMERACTIONSDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// Малює кнопки "Старт/Стоп" і "Видалити" прямо в клітинці замість окремих віджетів на кожен рядок
+class TimerActionsDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit TimerActionsDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    bool editorEvent(QEvent *event, QAbstractItemModel *model,
+                     const QStyleOptionViewItem &option, const QModelIndex &index) override;
+
+signals:
+    void toggleClicked(int id);
+    void deleteClicked(int id);
+
+private:
+    static QRect toggleRect(const QRect &cell);
+    static QRect deleteRect(const QRect &cell);
+};
+
+#endif // TIMERACTIONSDELEGATE_H
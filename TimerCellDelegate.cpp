@@ -0,0 +1,130 @@
+#include "TimerCellDelegate.h"
+#include "TimerTableModel.h"
+#include <QApplication>
+#include <QPainter>
+#include <QtMath>
+
+TimerCellDelegate::TimerCellDelegate(QObject *parent)
+    : QStyledItemDelegate(parent)
+{
+}
+
+namespace {
+
+QStaticText prepared(const QString &text, const QFont &font)
+{
+    QStaticText s(text);
+    s.setTextFormat(Qt::PlainText);
+    s.setPerformanceHint(QStaticText::AggressiveCaching);
+    s.prepare(QTransform(), font);
+    return s;
+}
+
+} // namespace
+
+void TimerCellDelegate::ensureGlyphs(const QFont &font) const
+{
+    if (glyphsReady && glyphs.font == font) return;
+
+    glyphs.font = font;
+    glyphs.pairWidth = 0;
+    for (int i = 0; i < 100; ++i) {
+        glyphs.pairs[i] = prepared(QString("%1").arg(i, 2, 10, QChar('0')), font);
+        glyphs.pairWidth = qMax(glyphs.pairWidth, glyphs.pairs[i].size().width());
+    }
+    glyphs.colon = prepared(":", font);
+    glyphs.colonWidth = glyphs.colon.size().width();
+    for (int i = 0; i < 10; ++i)
+        glyphs.tenths[i] = prepared(QString(".%1").arg(i), font);
+    glyphs.statuses.clear();
+    glyphsReady = true;
+}
+
+void TimerCellDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    int column = index.column();
+    if (column != TimerTableModel::TimeColumn && column != TimerTableModel::StatusColumn) {
+        QStyledItemDelegate::paint(painter, option, index);
+        return;
+    }
+
+    // Фон без initStyleOption: той прочитав би DisplayRole, а це і є форматування рядка
+    QStyleOptionViewItem opt(option);
+    opt.index = index;
+    opt.text.clear();
+    opt.features &= ~QStyleOptionViewItem::HasDisplay;
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, widget);
+
+    int flags = index.data(TimerTableModel::StatusFlagsRole).toInt();
+    ensureGlyphs(option.font);
+
+    QPalette::ColorGroup group = !(option.state & QStyle::State_Enabled) ? QPalette::Disabled
+                                 : (option.state & QStyle::State_Active) ? QPalette::Normal : QPalette::Inactive;
+    QPalette::ColorRole role = (option.state & QStyle::State_Selected) ? QPalette::HighlightedText : QPalette::Text;
+
+    int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    QRect rect = option.rect.adjusted(margin, 0, -margin, 0);
+
+    painter->save();
+    painter->setClipRect(option.rect);
+    painter->setFont(option.font);
+    painter->setPen(option.palette.color(group, role));
+
+    if (column == TimerTableModel::TimeColumn) {
+        paintTime(painter, rect, index.data(TimerTableModel::RemainingRole).toLongLong(), flags);
+    } else {
+        auto it = glyphs.statuses.find(flags);
+        if (it == glyphs.statuses.end())
+            it = glyphs.statuses.insert(flags, prepared(TimerTableModel::statusText(flags), option.font));
+        qreal y = rect.top() + (rect.height() - it->size().height()) / 2;
+        painter->drawStaticText(QPointF(rect.left(), y), *it);
+    }
+    painter->restore();
+}
+
+// Кожне поле на сталому місці, тож між тіками цифри не зсуваються і клітинка не "тремтить"
+void TimerCellDelegate::paintTime(QPainter *painter, const QRect &rect, qint64 remainingMs, int flags) const
+{
+    bool withTenths = flags & TimerTableModel::WithTenths;
+    qint64 tenths = TimerTableModel::displayTenths(TimerDuration(remainingMs), withTenths);
+    qint64 totalSeconds = tenths / 10;
+    qint64 h = totalSeconds / 3600;
+
+    qreal x = rect.left();
+    qreal y = rect.top() + (rect.height() - glyphs.colon.size().height()) / 2;
+
+    if (h < 100) {
+        painter->drawStaticText(QPointF(x, y), glyphs.pairs[h]);
+        x += glyphs.pairWidth;
+    } else {
+        // Понад 99 годин — рідкість, тут рядок не кешується
+        QString hours = QString::number(h);
+        QStaticText text(hours);
+        painter->drawStaticText(QPointF(x, y), text);
+        x += text.size().width();
+    }
+    painter->drawStaticText(QPointF(x, y), glyphs.colon);
+    x += glyphs.colonWidth;
+    painter->drawStaticText(QPointF(x, y), glyphs.pairs[(totalSeconds % 3600) / 60]);
+    x += glyphs.pairWidth;
+    painter->drawStaticText(QPointF(x, y), glyphs.colon);
+    x += glyphs.colonWidth;
+    painter->drawStaticText(QPointF(x, y), glyphs.pairs[totalSeconds % 60]);
+    x += glyphs.pairWidth;
+    if (withTenths) painter->drawStaticText(QPointF(x, y), glyphs.tenths[tenths % 10]);
+}
+
+QSize TimerCellDelegate::sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    if (index.column() != TimerTableModel::TimeColumn)
+        return QStyledItemDelegate::sizeHint(option, index);
+
+    ensureGlyphs(option.font);
+    const QWidget *widget = option.widget;
+    QStyle *style = widget ? widget->style() : QApplication::style();
+    int margin = style->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, widget) + 1;
+    qreal w = 3 * glyphs.pairWidth + 2 * glyphs.colonWidth + glyphs.tenths[0].size().width();
+    return QSize(qCeil(w) + 2 * margin, option.fontMetrics.height() + 2 * margin);
+}
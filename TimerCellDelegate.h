@@ -0,0 +1,40 @@
+#ifndef TIMERCELLDELEGATE_H
+#define TIMERCELLDELEGATE_H
+
+#include <QStyledItemDelegate>
+#include <QStaticText>
+#include <QFont>
+#include <QHash>
+
+// Малює колонки "Час" і "Статус" прямо з сирих значень моделі (RemainingRole, StatusFlagsRole).
+// Пари цифр 00..99, роздільники і тексти статусів розкладаються один раз у QStaticText,
+// тож тік відліку не створює жодного рядка на клітинку
+class TimerCellDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+
+public:
+    explicit TimerCellDelegate(QObject *parent = nullptr);
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+    QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    // Розкладки залежать від шрифту; кеш перебудовується, коли шрифт клітинки змінився
+    struct Glyphs {
+        QFont font;
+        QStaticText pairs[100];
+        QStaticText colon;
+        QStaticText tenths[10];    // ".0" .. ".9"
+        qreal pairWidth = 0;        // найширша пара цифр — поля стоять на сталих місцях
+        qreal colonWidth = 0;
+        QHash<int, QStaticText> statuses;
+    };
+    mutable Glyphs glyphs;
+    mutable bool glyphsReady = false;
+
+    void ensureGlyphs(const QFont &font) const;
+    void paintTime(QPainter *painter, const QRect &rect, qint64 remainingMs, int flags) const;
+};
+
+#endif // TIMERCELLDELEGATE_H
@@ -0,0 +1,170 @@
+#include "TimerClient.h"
+#include <QElapsedTimer>
+
+using namespace BinaryCodec;
+
+void TimerClient::Batch::add(const QString &name, TimerDuration duration, const TimerSchedule &schedule)
+{
+    put(commands, quint8(Ipc::CmdAdd));
+    putString(commands, name);
+    put(commands, qint64(duration.count()));
+    putSchedule(commands, schedule);
+    ++count;
+}
+
+void TimerClient::Batch::update(int id, const QString &name, TimerDuration duration)
+{
+    put(commands, quint8(Ipc::CmdUpdate));
+    put(commands, qint32(id));
+    putString(commands, name);
+    put(commands, qint64(duration.count()));
+    ++count;
+}
+
+void TimerClient::Batch::setSchedule(int id, const TimerSchedule &schedule)
+{
+    put(commands, quint8(Ipc::CmdSetSchedule));
+    put(commands, qint32(id));
+    putSchedule(commands, schedule);
+    ++count;
+}
+
+void TimerClient::Batch::queryAll()
+{
+    put(commands, quint8(Ipc::CmdQueryAll));
+    ++count;
+}
+
+void TimerClient::Batch::subscribe(quint8 mask)
+{
+    put(commands, quint8(Ipc::CmdSubscribe));
+    put(commands, mask);
+    ++count;
+}
+
+void TimerClient::Batch::simple(Ipc::Command op, int id)
+{
+    put(commands, quint8(op));
+    put(commands, qint32(id));
+    ++count;
+}
+
+TimerClient::TimerClient(QObject *parent)
+    : QObject(parent), nextSeq(1), awaitedSeq(0), awaitedDone(false)
+{
+    connect(&socket, &QLocalSocket::readyRead, this, &TimerClient::onReadyRead);
+    connect(&socket, &QLocalSocket::disconnected, this, &TimerClient::disconnected);
+}
+
+bool TimerClient::connectToServer(const QString &name, int timeoutMs)
+{
+    socket.connectToServer(name);
+    return socket.waitForConnected(timeoutMs);
+}
+
+quint32 TimerClient::send(const Batch &batch)
+{
+    if (!isConnected() || batch.isEmpty()) return 0;
+
+    quint32 seq = nextSeq++;
+    QByteArray body;
+    body.reserve(8 + batch.commands.size());
+    put(body, seq);
+    put(body, batch.count);
+    body.append(batch.commands);
+    socket.write(Ipc::frame(Ipc::FrameRequest, body));
+    return seq;
+}
+
+bool TimerClient::exec(const Batch &batch, QVector<Ipc::Result> *results, int timeoutMs)
+{
+    awaitedSeq = send(batch);
+    if (awaitedSeq == 0) return false;
+    awaitedDone = false;
+
+    QElapsedTimer timer;
+    timer.start();
+    socket.flush();
+    while (!awaitedDone && isConnected()) {
+        int left = timeoutMs - int(timer.elapsed());
+        if (left <= 0 || !socket.waitForReadyRead(left)) break;
+        onReadyRead();
+    }
+
+    awaitedSeq = 0;
+    if (awaitedDone && results) *results = std::move(awaitedResults);
+    awaitedResults.clear();
+    return awaitedDone;
+}
+
+void TimerClient::onReadyRead()
+{
+    buffer.append(socket.readAll());
+
+    quint8 type;
+    QByteArray body;
+    bool error = false;
+    while (Ipc::takeFrame(buffer, type, body, &error)) {
+        if (!handleFrame(type, body)) {
+            error = true;
+            break;
+        }
+    }
+    if (error) socket.disconnectFromServer();
+}
+
+bool TimerClient::handleFrame(quint8 type, const QByteArray &body)
+{
+    Reader r(body);
+
+    if (type == Ipc::FrameReply) {
+        quint32 seq, count;
+        if (!r.get(seq) || !r.get(count)) return false;
+
+        QVector<Ipc::Result> results;
+        results.reserve(int(qMin<quint32>(count, 1 << 20)));
+        for (quint32 i = 0; i < count; ++i) {
+            Ipc::Result res;
+            if (!r.get(res.command) || !r.get(res.status)) return false;
+
+            int records = 0;
+            if (res.command == Ipc::CmdQuery && res.status == 1) records = 1;
+            else if (res.command == Ipc::CmdQueryAll) records = res.status;
+            res.timers.resize(records);
+            for (StoredTimer &t : res.timers)
+                if (!Ipc::getTimer(r, t)) return false;
+            results.append(std::move(res));
+        }
+
+        if (seq == awaitedSeq) {
+            awaitedResults = results;
+            awaitedDone = true;
+        }
+        emit replyReceived(seq, results);
+        return true;
+    }
+
+    if (type == Ipc::FrameEvents) {
+        quint32 count;
+        if (!r.get(count)) return false;
+
+        QVector<Ipc::Event> events;
+        events.reserve(int(qMin<quint32>(count, 1 << 20)));
+        for (quint32 i = 0; i < count; ++i) {
+            Ipc::Event ev;
+            if (!r.get(ev.type)) return false;
+            if (ev.type == Ipc::EventRemoved) {
+                qint32 id;
+                if (!r.get(id)) return false;
+                ev.timer = StoredTimer{id, QString(), TimerDuration::zero(), 0, 0, TimerSchedule()};
+            } else if (!Ipc::getTimer(r, ev.timer)) {
+                return false;
+            }
+            events.append(std::move(ev));
+        }
+        emit eventsReceived(events);
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,72 @@
+#ifndef TIMERCLIENT_H
+#define TIMERCLIENT_H
+
+#include <QObject>
+#include <QLocalSocket>
+#include "IpcProtocol.h"
+
+// Клієнт протоколу керування таймерами. Команди збираються в Batch і йдуть одним кадром,
+// тож тисячі операцій коштують один обмін з сервером.
+class TimerClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    class Batch
+    {
+    public:
+        void add(const QString &name, TimerDuration duration, const TimerSchedule &schedule = TimerSchedule());
+        void start(int id) { simple(Ipc::CmdStart, id); }
+        void pause(int id) { simple(Ipc::CmdPause, id); }
+        void remove(int id) { simple(Ipc::CmdRemove, id); }
+        void reset(int id) { simple(Ipc::CmdReset, id); }
+        void update(int id, const QString &name, TimerDuration duration);
+        void setSchedule(int id, const TimerSchedule &schedule);
+        void query(int id) { simple(Ipc::CmdQuery, id); }
+        void queryAll();
+        void subscribe(quint8 mask);
+
+        int size() const { return int(count); }
+        bool isEmpty() const { return count == 0; }
+
+    private:
+        friend class TimerClient;
+        QByteArray commands;
+        quint32 count = 0;
+
+        void simple(Ipc::Command op, int id);
+    };
+
+    explicit TimerClient(QObject *parent = nullptr);
+
+    bool connectToServer(const QString &name, int timeoutMs = 3000);
+    bool isConnected() const { return socket.state() == QLocalSocket::ConnectedState; }
+    QString errorString() const { return socket.errorString(); }
+
+    // Повертає номер запиту (0 — не надіслано); відповідь прийде в replyReceived
+    quint32 send(const Batch &batch);
+
+    // Синхронний варіант для скриптів і початкового завантаження
+    bool exec(const Batch &batch, QVector<Ipc::Result> *results = nullptr, int timeoutMs = 30000);
+
+signals:
+    void replyReceived(quint32 seq, const QVector<Ipc::Result> &results);
+    void eventsReceived(const QVector<Ipc::Event> &events);
+    void disconnected();
+
+private slots:
+    void onReadyRead();
+
+private:
+    QLocalSocket socket;
+    QByteArray buffer;
+    quint32 nextSeq;
+
+    quint32 awaitedSeq;
+    bool awaitedDone;
+    QVector<Ipc::Result> awaitedResults;
+
+    bool handleFrame(quint8 type, const QByteArray &body);
+};
+
+#endif // TIMERCLIENT_H
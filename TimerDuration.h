@@ -0,0 +1,18 @@
+#ifndef TIMERDURATION_H
+#define TIMERDURATION_H
+
+#include <QtGlobal>
+#include <chrono>
+
+// Єдиний тип тривалості ядра: 64-бітні мілісекунди.
+// Неявно приймає std::chrono::seconds/minutes/hours, а голе число — ні,
+// тож переплутати секунди з мілісекундами не вийде вже на етапі компіляції.
+using TimerDuration = std::chrono::duration<qint64, std::milli>;
+
+// Округлення вгору до цілих секунд — так відлік показує "00:00:01" аж до самого спрацювання
+inline qint64 ceilSeconds(TimerDuration d)
+{
+    return std::chrono::ceil<std::chrono::seconds>(d).count();
+}
+
+#endif // TIMERDURATION_H
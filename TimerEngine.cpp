@@ -0,0 +1,115 @@
+#include "TimerEngine.h"
+#include <QDeadlineTimer>
+#include <QThread>
+#include <climits>
+
+TimerEngine::TimerEngine(QObject *receiver, QObject *parent)
+    : QObject(parent), receiver(receiver), wheel(nowTick())
+{
+    // Дочірній таймер переїжджає в потік рушія разом з ним
+    driver = new QTimer(this);
+    driver->setSingleShot(true);
+    driver->setTimerType(Qt::PreciseTimer);
+    connect(driver, &QTimer::timeout, this, &TimerEngine::handleTick);
+}
+
+TimingWheel::Tick TimerEngine::nowTick()
+{
+    return TimingWheel::Tick(QDeadlineTimer::current(Qt::PreciseTimer).deadline());
+}
+
+void TimerEngine::post(const EngineCommand &cmd)
+{
+    // Рушій ніколи не чекає на менеджера, тож коротке очікування тут не може зациклитись
+    while (!commands.push(cmd)) {
+        wake();
+        QThread::yieldCurrentThread();
+    }
+}
+
+void TimerEngine::wake()
+{
+    // Одне пробудження на пачку команд
+    if (!commandWakePending.exchange(true))
+        QMetaObject::invokeMethod(this, &TimerEngine::drainCommands, Qt::QueuedConnection);
+}
+
+bool TimerEngine::takeEvent(EngineEvent &event)
+{
+    eventWakePending.store(false);
+    return events.pop(event);
+}
+
+void TimerEngine::drainCommands()
+{
+    commandWakePending.store(false);
+
+    // Колесо простоювало — підтягуємо його до поточного часу
+    if (wheel.isEmpty()) {
+        QVector<int> none;
+        wheel.advance(nowTick(), none);
+    }
+
+    EngineCommand cmd;
+    while (commands.pop(cmd)) {
+        if (cmd.slot >= armed.size()) armed.resize(cmd.slot + 1);
+        ArmState &state = armed[cmd.slot];
+
+        if (state.node != -1) {
+            wheel.cancel(state.node);
+            state.node = -1;
+        }
+        if (cmd.type == EngineCommand::Arm) {
+            state.node = wheel.schedule(cmd.deadline, cmd.slot);
+            state.seq = cmd.seq;
+        }
+    }
+
+    // Команди могли прийти пізніше за дедлайн — обробляємо одразу
+    handleTick();
+}
+
+void TimerEngine::handleTick()
+{
+    QVector<int> expired;
+    TimingWheel::Tick now = nowTick();
+    wheel.advance(now, expired);
+
+    for (int slot : expired) {
+        ArmState &state = armed[slot];
+        state.node = -1;
+        backlog.append(EngineEvent{slot, state.seq, now});
+    }
+
+    publishEvents();
+    rescheduleDriver();
+}
+
+void TimerEngine::publishEvents()
+{
+    if (backlog.isEmpty()) return;
+
+    int sent = 0;
+    while (sent < backlog.size() && events.push(backlog[sent])) ++sent;
+    backlog.remove(0, sent);
+
+    if (sent > 0 && !eventWakePending.exchange(true))
+        QMetaObject::invokeMethod(receiver, "drainEngineEvents", Qt::QueuedConnection);
+
+    // Черга заповнена: пробуємо ще раз трохи згодом, не блокуючи рушій
+    if (!backlog.isEmpty())
+        QTimer::singleShot(1, this, &TimerEngine::publishEvents);
+}
+
+void TimerEngine::rescheduleDriver()
+{
+    if (wheel.isEmpty()) {
+        driver->stop();
+        return;
+    }
+
+    TimingWheel::Tick next = wheel.nextEventTick();
+    TimingWheel::Tick now = nowTick();
+    TimingWheel::Tick delay = next > now ? next - now : 0;
+    driver->start(int(qMin<TimingWheel::Tick>(delay, INT_MAX)));
+}
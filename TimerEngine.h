@@ -0,0 +1,72 @@
+#ifndef TIMERENGINE_H
+#define TIMERENGINE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <atomic>
+#include "SpscQueue.h"
+#include "TimingWheel.h"
+
+// Команда від менеджера до рушія: взвести / зняти таймер у слоті
+struct EngineCommand {
+    enum Type : quint8 { Arm, Disarm };
+
+    Type type;
+    int slot;
+    quint32 seq;                // номер взведення; застарілі події менеджер відкидає
+    TimingWheel::Tick deadline;
+};
+
+// Подія від рушія: таймер у слоті спрацював
+struct EngineEvent {
+    int slot;
+    quint32 seq;
+    TimingWheel::Tick firedAt;
+};
+
+// Рушій планування, що працює у власному потоці.
+// Команди надходять через безблокувальну чергу, події повертаються пачками через іншу.
+// Повільний діалог або перемальовування в GUI-потоці не затримують спрацювання.
+class TimerEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimerEngine(QObject *receiver, QObject *parent = nullptr);
+
+    // Викликаються з потоку менеджера
+    void post(const EngineCommand &cmd);
+    void wake();
+    bool takeEvent(EngineEvent &event);
+
+public slots:
+    void drainCommands();
+
+private slots:
+    void handleTick();
+
+private:
+    struct ArmState {
+        int node = -1;
+        quint32 seq = 0;
+    };
+
+    QObject *receiver;          // менеджер, якому шлеться drainEngineEvents
+    SpscQueue<EngineCommand> commands;
+    SpscQueue<EngineEvent> events;
+    QVector<EngineEvent> backlog;   // події, що не влізли в заповнену чергу
+    std::atomic<bool> commandWakePending{false};
+    std::atomic<bool> eventWakePending{false};
+
+    // Далі — стан, яким володіє лише потік рушія
+    QTimer *driver;
+    TimingWheel wheel;
+    QVector<ArmState> armed;
+
+    static TimingWheel::Tick nowTick();
+    void publishEvents();
+    void rescheduleDriver();
+};
+
+#endif // TIMERENGINE_H
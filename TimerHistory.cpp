@@ -0,0 +1,470 @@
+#include "TimerHistory.h"
+#include "TimerStore.h"
+#include "BinaryCodec.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QTimeZone>
+#include <algorithm>
+
+using namespace BinaryCodec;
+
+namespace {
+
+const quint32 HistoryMagic = 0x31485453;    // "STH1"
+const quint32 NamesMagic = 0x314E5453;      // "STN1"
+
+// Після поля довжини: count, firstMs, lastMs, maxRunMs, dictCount і розміри чотирьох колонок змінної довжини
+const int BlockHeaderSize = 4 + 8 + 8 + 8 + 4 * 5;
+
+struct Block {
+    quint32 count;
+    qint64 firstMs;
+    qint64 lastMs;
+    qint64 maxRunMs;
+    quint32 dictCount, dictBytes, timeBytes, refBytes, valueBytes;
+    const uchar *body;
+};
+
+// Заголовок блоку; r переходить на початок наступного
+bool readBlock(Reader &r, Block &b)
+{
+    quint32 bytes;
+    if (!r.get(bytes) || bytes < quint32(BlockHeaderSize)) return false;
+    if (!r.get(b.count) || !r.get(b.firstMs) || !r.get(b.lastMs) || !r.get(b.maxRunMs) || !r.get(b.dictCount)
+        || !r.get(b.dictBytes) || !r.get(b.timeBytes) || !r.get(b.refBytes) || !r.get(b.valueBytes))
+        return false;
+    b.body = r.pos();
+    qint64 body = qint64(b.dictBytes) + b.timeBytes + b.count + b.refBytes + b.valueBytes;
+    return body == bytes - BlockHeaderSize && r.skip(body);
+}
+
+// Події блоку по черзі: f(ms, id, подія, тривалість запуску). Колонку тривалостей лічильникам спрацювань не читаємо
+template <typename F>
+bool decodeBlock(const Block &b, bool withValues, QVector<int> &dict, F f)
+{
+    const uchar *p = b.body;
+    Reader dictColumn(p, b.dictBytes);
+    p += b.dictBytes;
+    Reader times(p, b.timeBytes);
+    p += b.timeBytes;
+    const uchar *events = p;
+    p += b.count;
+    Reader refs(p, b.refBytes);
+    p += b.refBytes;
+    Reader values(p, b.valueBytes);
+
+    dict.resize(b.dictCount);
+    quint64 delta;
+    qint64 id = 0;
+    for (quint32 i = 0; i < b.dictCount; ++i) {
+        if (!dictColumn.getVarint(delta)) return false;
+        id += qint64(delta);
+        dict[i] = int(id);
+    }
+
+    qint64 ms = b.firstMs;
+    for (quint32 i = 0; i < b.count; ++i) {
+        quint64 ref, run = 0;
+        if (!times.getVarint(delta) || !refs.getVarint(ref) || ref >= b.dictCount) return false;
+        ms += qint64(delta);
+        if (withValues && events[i] != TimerHistory::Start && !values.getVarint(run)) return false;
+        f(ms, dict[int(ref)], events[i], qint64(run));
+    }
+    return true;
+}
+
+qint64 monthStartMs(int month)
+{
+    return QDateTime(QDate(month / 12, month % 12 + 1, 1), QTime(0, 0), QTimeZone::utc()).toMSecsSinceEpoch();
+}
+
+} // namespace
+
+TimerHistory::TimerHistory(const QString &directory, QObject *parent)
+    : QObject(parent), directory(directory), timeSource(Clock::system())
+{
+    QDir().mkpath(directory);
+
+    // Скидання раз на кілька секунд: незаповнений блок переписується рідше, а втратити можна лише ці секунди
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(5000);
+    connect(&flushTimer, &QTimer::timeout, this, &TimerHistory::flush);
+
+    load();
+}
+
+TimerHistory::~TimerHistory()
+{
+    flush();
+}
+
+QString TimerHistory::defaultDirectory()
+{
+    return QDir(TimerStore::defaultDirectory()).filePath("history");
+}
+
+int TimerHistory::monthOf(qint64 ms)
+{
+    QDate date = QDateTime::fromMSecsSinceEpoch(ms, QTimeZone::utc()).date();
+    return date.year() * 12 + date.month() - 1;
+}
+
+QString TimerHistory::monthPath(int month) const
+{
+    return QDir(directory).filePath(QString("%1-%2.hist").arg(month / 12).arg(month % 12 + 1, 2, 10, QChar('0')));
+}
+
+QVector<int> TimerHistory::months() const
+{
+    QVector<int> list;
+    for (const QString &file : QDir(directory).entryList({"*.hist"}, QDir::Files, QDir::Name)) {
+        bool yearOk, monthOk;
+        int year = file.left(4).toInt(&yearOk);
+        int month = file.mid(5, 2).toInt(&monthOk);
+        if (yearOk && monthOk && month >= 1 && month <= 12) list.append(year * 12 + month - 1);
+    }
+    return list;
+}
+
+qint64 TimerHistory::diskSize() const
+{
+    qint64 total = QFileInfo(QDir(directory).filePath("names.dat")).size();
+    for (int month : months()) total += QFileInfo(monthPath(month)).size();
+    return total;
+}
+
+// Лічильник подій — із заголовків; незавершені запуски відновлюються з двох останніх місяців,
+// тож довший запуск після перезапуску програми рахується лише з моменту attachHistory. Запуски, що
+// закінчились без програми, закриває менеджер у attachHistory — за станом, відновленим зі сховища
+void TimerHistory::load()
+{
+    QString namesPath = QDir(directory).filePath("names.dat");
+    QFile namesFile(namesPath);
+    if (namesFile.open(QIODevice::ReadOnly)) {
+        QByteArray data = namesFile.readAll();
+        namesFile.close();
+        Reader r(data);
+        quint32 magic;
+        qint64 valid = 0;
+        if (r.get(magic) && magic == NamesMagic) {
+            valid = 4;
+            qint32 id;
+            QString name;
+            while (r.get(id) && r.getString(name)) {
+                names.insert(id, name);
+                valid = r.pos() - reinterpret_cast<const uchar*>(data.constData());
+            }
+        }
+        if (valid < data.size()) QFile::resize(namesPath, valid);
+    }
+
+    QVector<int> list = months();
+    QVector<int> dict;
+    for (int k = 0; k < list.size(); ++k) {
+        bool recent = k >= list.size() - 2;
+        bool newest = k == list.size() - 1;
+        QString path = monthPath(list[k]);
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) || file.size() < 4) continue;
+        uchar *data = file.map(0, file.size());
+        if (!data) continue;
+
+        Reader r(data, file.size());
+        quint32 magic;
+        qint64 valid = 0;
+        QVector<Entry> lastBlock;
+        qint64 lastBlockOffset = 0;
+        if (r.get(magic) && magic == HistoryMagic) {
+            valid = 4;
+            Block b;
+            while (readBlock(r, b)) {
+                QVector<Entry> decoded;
+                bool ok = !recent || decodeBlock(b, true, dict, [&](qint64 ms, int id, quint8 event, qint64 run) {
+                    if (event == Start) openRuns.insert(id, ms);
+                    else openRuns.remove(id);
+                    if (newest) decoded.append({ms, run, id, event});
+                });
+                if (!ok) break;
+                if (newest) {
+                    lastBlock = std::move(decoded);
+                    lastBlockOffset = valid;
+                }
+                storedEvents += b.count;
+                lastMs = qMax(lastMs, b.lastMs);
+                valid = r.pos() - data;
+            }
+        }
+        qint64 size = file.size();
+        file.unmap(data);
+        file.close();
+
+        if (!newest) continue;
+        // Обрізаний хвіст після збою прибираємо, інакше нові блоки ляжуть після сміття
+        if (valid < size) QFile::resize(path, valid);
+        if (!lastBlock.isEmpty() && lastBlock.size() < BlockEvents) {
+            tail = lastBlock;
+            tailOffset = lastBlockOffset;
+            tailMonth = list[k];
+        }
+    }
+}
+
+void TimerHistory::record(Event event, int id)
+{
+    recordAt(event, id, timeSource->wallMs());
+}
+
+void TimerHistory::recordAt(Event event, int id, qint64 wallMs)
+{
+    qint64 now = qMax(lastMs, wallMs);
+    lastMs = now;
+
+    qint64 run = 0;
+    if (event == Start) {
+        openRuns.insert(id, now);
+    } else {
+        auto it = openRuns.find(id);
+        if (it != openRuns.end()) {
+            run = now - *it;
+            openRuns.erase(it);
+        }
+    }
+    pending.append({now, run, id, quint8(event)});
+
+    if (pending.size() >= BlockEvents) flush();
+    else if (!flushTimer.isActive()) flushTimer.start();
+}
+
+void TimerHistory::recordName(int id, const QString &name)
+{
+    auto it = names.find(id);
+    if (it != names.end() && *it == name) return;
+    names.insert(id, name);
+    put(pendingNames, qint32(id));
+    putString(pendingNames, name);
+    if (!flushTimer.isActive()) flushTimer.start();
+}
+
+void TimerHistory::writeBlocks(QFile &file, const QVector<Entry> &entries)
+{
+    QByteArray out;
+    QVector<int> dict;
+    QByteArray dictColumn, times, events, refs, values;
+
+    for (int begin = 0; begin < entries.size(); begin += BlockEvents) {
+        int end = qMin(begin + BlockEvents, int(entries.size()));
+
+        // Словник блоку — відсортовані id; у колонці подій лише індекси в ньому, здебільшого по байту
+        dict.clear();
+        for (int i = begin; i < end; ++i) dict.append(entries[i].id);
+        std::sort(dict.begin(), dict.end());
+        dict.erase(std::unique(dict.begin(), dict.end()), dict.end());
+
+        dictColumn.clear();
+        times.clear();
+        events.clear();
+        refs.clear();
+        values.clear();
+        int previousId = 0;
+        for (int id : dict) {
+            putVarint(dictColumn, quint64(id - previousId));
+            previousId = id;
+        }
+        qint64 previousMs = entries[begin].ms;
+        qint64 maxRun = 0;
+        for (int i = begin; i < end; ++i) {
+            const Entry &e = entries[i];
+            putVarint(times, quint64(e.ms - previousMs));
+            previousMs = e.ms;
+            events.append(char(e.event));
+            putVarint(refs, quint64(std::lower_bound(dict.begin(), dict.end(), e.id) - dict.begin()));
+            if (e.event != Start) putVarint(values, quint64(e.value));
+            maxRun = qMax(maxRun, e.value);
+        }
+
+        out.clear();
+        put(out, quint32(BlockHeaderSize + dictColumn.size() + times.size() + events.size() + refs.size() + values.size()));
+        put(out, quint32(end - begin));
+        put(out, entries[begin].ms);
+        put(out, entries[end - 1].ms);
+        put(out, maxRun);
+        put(out, quint32(dict.size()));
+        put(out, quint32(dictColumn.size()));
+        put(out, quint32(times.size()));
+        put(out, quint32(refs.size()));
+        put(out, quint32(values.size()));
+        out += dictColumn;
+        out += times;
+        out += events;
+        out += refs;
+        out += values;
+
+        qint64 offset = file.pos();
+        file.write(out);
+        if (end - begin < BlockEvents) {
+            tail = entries.mid(begin, end - begin);
+            tailOffset = offset;
+        } else {
+            tail.clear();
+            tailOffset = file.pos();
+        }
+    }
+}
+
+void TimerHistory::flush()
+{
+    if (!pendingNames.isEmpty()) {
+        QFile namesFile(QDir(directory).filePath("names.dat"));
+        if (namesFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            if (namesFile.size() == 0) {
+                QByteArray header;
+                put(header, NamesMagic);
+                namesFile.write(header);
+            }
+            namesFile.write(pendingNames);
+        }
+        pendingNames.clear();
+    }
+
+    // Якщо файл не відкрився, події відкидаються: історія не повинна рости в пам'яті без меж
+    for (int begin = 0; begin < pending.size();) {
+        int month = monthOf(pending[begin].ms);
+        qint64 monthEnd = monthStartMs(month + 1);
+        int end = begin;
+        while (end < pending.size() && pending[end].ms < monthEnd) ++end;
+
+        QFile file(monthPath(month));
+        if (file.open(QIODevice::ReadWrite)) {
+            QVector<Entry> entries;
+            if (month == tailMonth && file.size() >= tailOffset) {
+                // Незаповнений останній блок переписується разом з новими подіями
+                entries = tail;
+                storedEvents -= tail.size();
+                file.resize(tailOffset);
+                file.seek(tailOffset);
+            } else {
+                if (file.size() == 0) {
+                    QByteArray header;
+                    put(header, HistoryMagic);
+                    file.write(header);
+                }
+                file.seek(file.size());
+                tail.clear();
+                tailMonth = month;
+            }
+            entries += pending.mid(begin, end - begin);
+            writeBlocks(file, entries);
+            storedEvents += entries.size();
+        }
+        begin = end;
+    }
+    pending.clear();
+}
+
+TimerHistory::Aggregate TimerHistory::buckets(qint64 fromMs, qint64 toMs, Period period)
+{
+    Aggregate a;
+    QDateTime t = QDateTime::fromMSecsSinceEpoch(fromMs);
+    t = period == Day ? t.date().startOfDay() : QDateTime(t.date(), QTime(t.time().hour(), 0));
+    while (t.toMSecsSinceEpoch() < toMs) {
+        a.bucketStarts.append(t.toMSecsSinceEpoch());
+        t = period == Day ? t.addDays(1) : t.addSecs(3600);
+    }
+    a.bucketStarts.append(t.toMSecsSinceEpoch());
+    a.total.resize(a.bucketStarts.size() - 1);
+    return a;
+}
+
+// Події з кінцем у [fromMs, toMs); для запусків (runs) — ті, чий проміжок роботи перетинає [fromMs, toMs).
+// Блок пропускається за заголовком, якщо його проміжок з урахуванням найдовшого запуску не перетинає запит.
+// Запуски, що закінчились пізніше за наступний після toMs місяць, не враховуються
+template <typename F>
+void TimerHistory::scan(qint64 fromMs, qint64 toMs, bool runs, F visit, qint64 &scanned) const
+{
+    auto wanted = [=](qint64 ms, qint64 run) {
+        return runs ? ms > fromMs && ms - run < toMs : ms >= fromMs && ms < toMs;
+    };
+
+    int firstMonth = monthOf(fromMs);
+    int lastMonth = monthOf(qMax(fromMs, toMs - 1)) + (runs ? 1 : 0);
+    QVector<int> dict;
+    for (int month : months()) {
+        if (month < firstMonth || month > lastMonth) continue;
+        QFile file(monthPath(month));
+        if (!file.open(QIODevice::ReadOnly)) continue;
+        uchar *data = file.map(0, file.size());
+        if (!data) continue;
+
+        Reader r(data, file.size());
+        quint32 magic;
+        Block b;
+        if (r.get(magic) && magic == HistoryMagic) {
+            while (readBlock(r, b)) {
+                if (b.lastMs < fromMs) continue;
+                if (b.firstMs - (runs ? b.maxRunMs : 0) >= toMs) {
+                    if (!runs) break;
+                    continue;
+                }
+                scanned += b.count;
+                decodeBlock(b, runs, dict, [&](qint64 ms, int id, quint8 event, qint64 run) {
+                    if (wanted(ms, run)) visit(ms, id, event, run);
+                });
+            }
+        }
+        file.unmap(data);
+    }
+
+    scanned += pending.size();
+    for (const Entry &e : pending) {
+        if (wanted(e.ms, e.value)) visit(e.ms, e.id, e.event, e.value);
+    }
+}
+
+TimerHistory::Aggregate TimerHistory::runTime(qint64 fromMs, qint64 toMs, Period period, int timerId) const
+{
+    Aggregate a = buckets(fromMs, toMs, period);
+    const qint64 *starts = a.bucketStarts.constData();
+    const int n = a.total.size();
+    const qint64 from = starts[0];
+    const qint64 to = starts[n];
+
+    auto add = [&](int id, qint64 begin, qint64 end) {
+        if (timerId && id != timerId) return;
+        begin = qMax(begin, from);
+        end = qMin(end, to);
+        if (begin >= end) return;
+        QVector<qint64> &row = a.byTimer[id];
+        if (row.isEmpty()) row.resize(n);
+        for (int i = int(std::upper_bound(starts, starts + n, begin) - starts) - 1; i < n && starts[i] < end; ++i) {
+            qint64 part = qMin(end, starts[i + 1]) - qMax(begin, starts[i]);
+            row[i] += part;
+            a.total[i] += part;
+        }
+    };
+
+    scan(from, to, true, [&](qint64 ms, int id, quint8 event, qint64 run) {
+        if (event != Start && run > 0) add(id, ms - run, ms);
+    }, a.scannedEvents);
+
+    qint64 now = timeSource->wallMs();
+    for (auto it = openRuns.cbegin(); it != openRuns.cend(); ++it) add(it.key(), it.value(), now);
+    return a;
+}
+
+TimerHistory::Aggregate TimerHistory::expiries(qint64 fromMs, qint64 toMs, Period period, int timerId) const
+{
+    Aggregate a = buckets(fromMs, toMs, period);
+    const qint64 *starts = a.bucketStarts.constData();
+    const int n = a.total.size();
+
+    scan(starts[0], starts[n], false, [&](qint64 ms, int id, quint8 event, qint64) {
+        if (event != Finish || (timerId && id != timerId)) return;
+        int i = int(std::upper_bound(starts, starts + n, ms) - starts) - 1;
+        QVector<qint64> &row = a.byTimer[id];
+        if (row.isEmpty()) row.resize(n);
+        ++row[i];
+        ++a.total[i];
+    }, a.scannedEvents);
+    return a;
+}
@@ -0,0 +1,110 @@
+#ifndef TIMERHISTORY_H
+#define TIMERHISTORY_H
+
+#include <QObject>
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include "Clock.h"
+
+// Історія запусків таймерів: журнал подій (старт, пауза, редагування, спрацювання, видалення), що лише дописується.
+// Файл на кожен місяць (UTC), у файлі — блоки до BlockEvents подій, збережені по колонках:
+// час — дельтами змінної довжини, id — індексами в словнику блоку, вид — байтом, тривалість запуску — числом
+// змінної довжини. Заголовок блоку містить його проміжок часу й найдовший запуск, тож запит читає лише
+// заголовки і ті блоки, що перетинають його проміжок; файли відображаються в пам'ять, а не читаються цілком.
+// Незаповнений останній блок переписується при кожному скиданні, доки не заповниться
+class TimerHistory : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Event : quint8 {
+        Start = 1,
+        Pause,
+        Edit,       // редагування зупиняє запущений таймер
+        Finish,     // повторюваний таймер після спрацювання одразу отримує новий Start
+        Remove
+    };
+
+    enum Period {
+        Hour,
+        Day
+    };
+
+    // Значення по інтервалах місцевого часу: bucketStarts має на один елемент більше — останній є кінцем
+    struct Aggregate {
+        QVector<qint64> bucketStarts;
+        QVector<qint64> total;
+        QHash<int, QVector<qint64>> byTimer;
+        qint64 scannedEvents = 0;   // скільки подій довелося декодувати
+    };
+
+    static constexpr int BlockEvents = 4096;
+
+    explicit TimerHistory(const QString &directory, QObject *parent = nullptr);
+    ~TimerHistory();
+
+    // Підкаталог history поруч зі сховищем таймерів
+    static QString defaultDirectory();
+
+    // Годинник менеджера: від нього час подій і "зараз" для незавершених запусків
+    void setClock(Clock *clock) { timeSource = clock; }
+
+    void record(Event event, int id);
+    // Подія заднім числом (спрацювання, що минуло, поки програма не працювала); час не раніше за останню подію
+    void recordAt(Event event, int id, qint64 wallMs);
+    // Таймери, чий запуск за історією ще триває
+    QList<int> openRunIds() const { return openRuns.keys(); }
+    // Назви пишуться окремим файлом і лише при зміні; видалені таймери зберігають останню назву
+    void recordName(int id, const QString &name);
+    QString nameOf(int id) const { return names.value(id); }
+
+    // Час роботи, мс. Запуск, що перетинає межу інтервалу, ділиться між інтервалами;
+    // запущені зараз таймери враховуються до поточного моменту. timerId 0 — усі таймери
+    Aggregate runTime(qint64 fromMs, qint64 toMs, Period period, int timerId = 0) const;
+    // Кількість спрацювань
+    Aggregate expiries(qint64 fromMs, qint64 toMs, Period period, int timerId = 0) const;
+
+    qint64 eventCount() const { return storedEvents + pending.size(); }
+    qint64 diskSize() const;
+
+public slots:
+    void flush();
+
+private:
+    struct Entry {
+        qint64 ms;
+        qint64 value;   // тривалість запуску, що закінчився цією подією
+        int id;
+        quint8 event;
+    };
+
+    QString directory;
+    Clock *timeSource;
+
+    QVector<Entry> pending;
+    QVector<Entry> tail;        // незаповнений останній блок, уже записаний у файл з номером tailMonth
+    int tailMonth = -1;
+    qint64 tailOffset = 0;
+    qint64 lastMs = 0;          // час подій не спадає, навіть якщо настінний годинник перевели назад
+    qint64 storedEvents = 0;
+    QHash<int, qint64> openRuns;
+
+    QHash<int, QString> names;
+    QByteArray pendingNames;
+    QTimer flushTimer;
+
+    static int monthOf(qint64 ms);
+    QString monthPath(int month) const;
+    QVector<int> months() const;
+    void load();
+    void writeBlocks(QFile &file, const QVector<Entry> &entries);
+
+    template <typename F>
+    void scan(qint64 fromMs, qint64 toMs, bool runs, F visit, qint64 &scanned) const;
+    static Aggregate buckets(qint64 fromMs, qint64 toMs, Period period);
+};
+
+#endif // TIMERHISTORY_H
@@ -1,137 +1,1134 @@
 #include "TimerManager.h"
+#include "TimerStore.h"
+#include "TimerHistory.h"
+#include "TimerEngine.h"
+#include <QThread>
+#include <algorithm>
+#include <climits>
 
 TimerManager::TimerManager(QObject *parent)
-    : QObject(parent), nextId(1)
+    : QObject(parent), nextId(1), wheel(nowTick()), runningTotal(0), store(nullptr),
+      engineThread(nullptr), engine(nullptr), armCounter(0)
 {
+    driver.setSingleShot(true);
+    driver.setTimerType(Qt::PreciseTimer);
+    connect(&driver, &ClockTimer::timeout, this, &TimerManager::handleTick);
+
+    calendarDriver.setSingleShot(true);
+    connect(&calendarDriver, &ClockTimer::timeout, this, &TimerManager::handleCalendarTick);
+
+    groupDriver.setSingleShot(true);
+    connect(&groupDriver, &ClockTimer::timeout, this, &TimerManager::handleGroupTick);
+
+    notifyTimer.setSingleShot(true);
+    notifyTimer.setInterval(16);
+    connect(&notifyTimer, &ClockTimer::timeout, this, &TimerManager::flushUpdates);
+
+    connect(this, &TimerManager::groupsChanged, this, [this]() {
+        clocksChanged = true;
+        schedulePublish();
+    });
 }
 
 TimerManager::~TimerManager()
 {
-    for (auto &t : timers) {
-        delete t.qtimer;
+    setEngineThreadEnabled(false);
+}
+
+TimingWheel::Tick TimerManager::nowTick() const
+{
+    // Тік колеса — мілісекунда монотонного годинника
+    return TimingWheel::Tick(timers.nowMs());
+}
+
+void TimerManager::setClock(Clock *clock)
+{
+    Q_ASSERT(timers.size() == 0);
+    if (!clock) clock = Clock::system();
+
+    // Рушій у потоці живе за системним часом, тож із симульованим годинником він вимикається
+    if (clock->simulated()) setEngineThreadEnabled(false);
+
+    timers.setClock(clock);
+    for (ClockTimer *timer : {&driver, &calendarDriver, &groupDriver, &notifyTimer}) timer->setClock(clock);
+    if (history) history->setClock(clock);
+    wheel = TimingWheel(nowTick());
+}
+
+void TimerManager::setCompactMode(bool compact)
+{
+    Q_ASSERT(timers.capacity() == 0);
+    timers.setCompact(compact);
+    idByName.clear();
+    fingerprints.clear();
+}
+
+int TimerManager::slotOf(int id) const
+{
+    return id > 0 && id < slotById.size() ? slotById[id] : -1;
+}
+
+SlotHandle TimerManager::handleOf(int id) const
+{
+    int slot = slotOf(id);
+    return slot < 0 ? SlotHandle() : timers.handle(slot);
+}
+
+void TimerManager::bindId(int id, int slot)
+{
+    while (slotById.size() <= id) slotById.append(-1);
+    slotById[id] = slot;
+}
+
+TimerView TimerManager::getTimerById(int id) const
+{
+    int slot = slotOf(id);
+    return slot < 0 ? TimerView() : TimerView(&timers, slot);
+}
+
+int TimerManager::addTimer(const QString &name, TimerDuration duration, const TimerSchedule &schedule)
+{
+    int id = nextId++;
+    SlotHandle h = timers.insert(id, name, duration);
+    timers.setSchedule(h.index, schedule);
+    bindId(id, h.index);
+    indexName(id, name);
+    reorder(h.index);
+    if (store) {
+        store->logAdd(id, name, duration);
+        if (schedule.isRecurring()) store->logSchedule(id, schedule);
     }
+    if (history) history->recordName(id, name);
+
+    schedulePublish();
+    emit timerAdded(id);
+    return id;
 }
 
-TimerEntry* TimerManager::getTimerById(int id)
+QVector<int> TimerManager::addTimers(const QVector<NewTimer> &list, QVector<int> *rejected)
 {
-    for (auto &t : timers) {
-        if (t.id == id) return &t;
+    QVector<int> ids;
+    ids.reserve(list.size());
+    if (!adding) reserveFor(list.size());
+
+    // Назви, додані раніше в цій пачці, вже проіндексовані — дублікати всередині пачки теж відхиляються
+    for (int i = 0; i < list.size(); ++i) {
+        const NewTimer &t = list[i];
+        bool calendar = t.schedule.kind == TimerSchedule::Calendar;
+        if (t.name.isEmpty() || !isNameUnique(t.name)
+            || (calendar ? !t.schedule.cron.isValid() : t.duration <= TimerDuration::zero())) {
+            if (rejected) rejected->append(i);
+            continue;
+        }
+
+        int id = nextId++;
+        SlotHandle h = timers.insert(id, t.name, t.duration);
+        timers.setSchedule(h.index, t.schedule);
+        bindId(id, h.index);
+        indexName(id, t.name);
+        reorder(h.index);
+        if (store) {
+            store->logAdd(id, t.name, t.duration);
+            if (t.schedule.isRecurring()) store->logSchedule(id, t.schedule);
+        }
+        if (history) history->recordName(id, t.name);
+        ids.append(id);
+    }
+
+    if (adding) {
+        addedIds += ids;
+    } else if (!ids.isEmpty()) {
+        schedulePublish();
+        emit timersAdded(ids);
     }
-    return nullptr;
+    return ids;
 }
 
-int TimerManager::addTimer(const QString &name, int durationSeconds)
+void TimerManager::beginAdding(int expected)
 {
-    TimerEntry e;
-    e.id = nextId++;
-    e.name = name;
-    e.durationSeconds = durationSeconds;
-    e.remainingSeconds = durationSeconds;
-    e.running = false;
+    adding = true;
+    addedIds.clear();
+    reserveFor(expected);
+}
 
-    e.qtimer = new QTimer(this);
-    e.qtimer->setInterval(1000);
-    connect(e.qtimer, &QTimer::timeout, this, &TimerManager::handleTick);
+void TimerManager::endAdding()
+{
+    adding = false;
+    if (addedIds.isEmpty()) return;
+    QVector<int> ids;
+    ids.swap(addedIds);
+    schedulePublish();
+    emit timersAdded(ids);
+}
 
-    timers.append(e);
-    return e.id;
+void TimerManager::reserveFor(int count)
+{
+    timers.reserve(timers.size() + count);
+    slotById.reserve(nextId + count);
+    if (timers.isCompact()) fingerprints.reserve(timers.size() + count);
+    else idByName.reserve(idByName.size() + count);
 }
 
 bool TimerManager::removeTimer(int id)
 {
-    for (int i = 0; i < timers.size(); ++i) {
-        if (timers[i].id == id) {
-            timers[i].qtimer->stop();
-            delete timers[i].qtimer;
-            timers.removeAt(i);
-            return true;
+    return removeTimers({id}) > 0;
+}
+
+bool TimerManager::startTimer(int id)
+{
+    return startTimers({id}) > 0;
+}
+
+bool TimerManager::pauseTimer(int id)
+{
+    return pauseTimers({id}) > 0;
+}
+
+int TimerManager::startTimers(const QList<int> &ids)
+{
+    // Колесо могло довго простоювати — підтягуємо його до поточного часу
+    if (wheel.isEmpty()) {
+        QVector<int> none;
+        wheel.advance(nowTick(), none);
+    }
+
+    int changed = 0;
+    for (int id : ids) {
+        int slot = slotOf(id);
+        if (slot < 0 || !arm(slot)) continue;
+        logStart(slot);
+        if (history && timers.isTicking(slot)) history->record(TimerHistory::Start, id);
+        notifyUpdated(id, TimerView(&timers, slot).remaining(), true);
+        ++changed;
+    }
+
+    if (changed) rescheduleDriver();
+    return changed;
+}
+
+int TimerManager::pauseTimers(const QList<int> &ids)
+{
+    int changed = 0;
+    for (int id : ids) {
+        int slot = slotOf(id);
+        if (slot < 0 || !timers.isRunning(slot)) continue;
+        disarm(slot);
+        if (store) store->logPause(id, timers.remaining(slot).count());
+        if (history) history->record(TimerHistory::Pause, id);
+        notifyUpdated(id, TimerView(&timers, slot).remaining(), false);
+        ++changed;
+    }
+
+    if (changed) rescheduleDriver();
+    return changed;
+}
+
+int TimerManager::resetTimers(const QList<int> &ids)
+{
+    int changed = 0;
+    for (int id : ids) {
+        int slot = slotOf(id);
+        if (slot < 0) continue;
+        if (history && timers.isRunning(slot)) history->record(TimerHistory::Pause, id);
+        disarm(slot);
+        timers.setRemaining(slot, timers.duration(slot));
+        if (store) store->logPause(id, timers.remaining(slot).count());
+        notifyUpdated(id, TimerView(&timers, slot).remaining(), false);
+        ++changed;
+    }
+
+    if (changed) rescheduleDriver();
+    return changed;
+}
+
+int TimerManager::removeTimers(const QList<int> &ids)
+{
+    QVector<int> removed;
+    removed.reserve(ids.size());
+
+    for (int id : ids) {
+        int slot = slotOf(id);
+        if (slot < 0) continue;
+
+        disarm(slot);
+        unindexName(id, timers.name(slot));
+        if (expiryOrderBuilt) expiryOrder.remove(id);
+        timers.remove(timers.handle(slot));
+        slotById[id] = -1;
+        dirtyIds.remove(id);
+        if (store) store->logRemove(id);
+        if (history) history->record(TimerHistory::Remove, id);
+        removed.append(id);
+    }
+
+    if (removed.isEmpty()) return 0;
+
+    rescheduleDriver();
+    schedulePublish();
+    emit timersRemoved(removed);
+    return removed.size();
+}
+
+void TimerManager::restoreTimers(const QVector<StoredTimer> &list, int restoredNextId)
+{
+    timers.reserve(timers.size() + list.size());
+    slotById.reserve(restoredNextId);
+    if (timers.isCompact()) fingerprints.reserve(timers.size() + list.size());
+    else idByName.reserve(idByName.size() + list.size());
+
+    for (const StoredTimer &s : list) {
+        SlotHandle h = timers.insert(s.id, s.name, s.duration);
+        timers.setRemaining(h.index, TimerDuration(s.remainingMs));
+        timers.setSchedule(h.index, s.schedule);
+        if (timers.clocks().contains(s.group)) timers.setGroup(h.index, s.group);
+        timers.setActions(h.index, s.actions);
+        bindId(s.id, h.index);
+        indexName(s.id, s.name);
+        if (s.wallDeadlineMs != 0) arm(h.index);
+        else if (s.expiredAtMs != 0) expiredOnRestore.insert(s.id, s.expiredAtMs);
+        reorder(h.index);
+    }
+
+    nextId = qMax(nextId, restoredNextId);
+    rescheduleDriver();
+}
+
+void TimerManager::mirrorTimer(const StoredTimer &s)
+{
+    int slot = slotOf(s.id);
+    bool added = slot < 0;
+    if (added) {
+        SlotHandle h = timers.insert(s.id, s.name, s.duration);
+        bindId(s.id, h.index);
+        indexName(s.id, s.name);
+        nextId = qMax(nextId, s.id + 1);
+        slot = h.index;
+    } else {
+        disarm(slot);
+        if (timers.name(slot) != s.name) {
+            unindexName(s.id, timers.name(slot));
+            indexName(s.id, s.name);
+            timers.setName(slot, s.name);
+        }
+        timers.setDuration(slot, s.duration);
+    }
+
+    // Дедлайн переданий за настінним годинником — так враховується час доставки
+    timers.setSchedule(slot, s.schedule);
+    timers.setRemaining(slot, TimerDuration(s.wallDeadlineMs != 0
+                                                ? qMax<qint64>(0, s.wallDeadlineMs - timers.clock()->wallMs())
+                                                : s.remainingMs));
+    if (s.wallDeadlineMs != 0) {
+        if (wheel.isEmpty()) {
+            QVector<int> none;
+            wheel.advance(nowTick(), none);
         }
+        arm(slot);
     }
-    return false;
+    rescheduleDriver();
+
+    if (added) emit timerAdded(s.id);
+    notifyUpdated(s.id, TimerView(&timers, slot).remaining(), timers.isRunning(slot));
 }
 
-bool TimerManager::startTimer(int id)
+bool TimerManager::arm(int slot)
 {
-    TimerEntry* t = getTimerById(id);
-    if (!t || t->running || t->remainingSeconds <= 0)
+    if (timers.isRunning(slot))
         return false;
 
-    t->running = true;
-    t->qtimer->start();
-    emit timerUpdated(id, t->remainingSeconds, true);
+    if (isCalendar(slot)) {
+        if (!armCalendar(slot)) return false;
+    } else {
+        if (timers.remaining(slot) <= TimerDuration::zero()) return false;
+        placeOnWheel(slot, timers.clockNow(slot, timers.nowMs()) + timers.remaining(slot).count());
+    }
+    timers.setRunning(slot, true);
+    ++runningTotal;
     return true;
 }
 
-bool TimerManager::pauseTimer(int id)
+void TimerManager::disarm(int slot)
 {
-    TimerEntry* t = getTimerById(id);
-    if (!t || !t->running)
+    if (!timers.isRunning(slot)) return;
+
+    timers.setRemaining(slot, timers.remainingNow(slot, timers.nowMs()));
+    if (isCalendar(slot))
+        calendar.remove(slot);
+    else if (int group = timers.group(slot))
+        groupDue[group].erase({timers.deadline(slot), slot});
+    else if (engine)
+        engine->post({EngineCommand::Disarm, slot, timers.armSeq(slot), 0});
+    else
+        wheel.cancel(timers.wheelNode(slot));
+    timers.setWheelNode(slot, -1);
+    timers.setRunning(slot, false);
+    --runningTotal;
+}
+
+void TimerManager::placeOnWheel(int slot, qint64 deadline)
+{
+    quint32 seq = ++armCounter;
+    timers.setDeadline(slot, deadline);
+    timers.setArmSeq(slot, seq);
+    if (int group = timers.group(slot))
+        groupDue[group].insert({deadline, slot});
+    else if (engine)
+        engine->post({EngineCommand::Arm, slot, seq, TimingWheel::Tick(deadline)});
+    else
+        timers.setWheelNode(slot, wheel.schedule(TimingWheel::Tick(deadline), slot));
+}
+
+bool TimerManager::armCalendar(int slot)
+{
+    qint64 wallNow = timers.clock()->wallMs();
+    qint64 next = timers.schedule(slot).cron.nextAfterMs(wallNow);
+    if (next < 0) return false;
+
+    // Монотонний дедлайн потрібен лише для показу залишку; спрацювання веде купа за настінним часом
+    timers.setDeadline(slot, timers.nowMs() + (next - wallNow));
+    timers.setRemaining(slot, TimerDuration(next - wallNow));
+    calendar.push(slot, next);
+    return true;
+}
+
+bool TimerManager::rearm(int slot)
+{
+    const TimerSchedule &schedule = timers.schedule(slot);
+    if (schedule.kind == TimerSchedule::Calendar) return armCalendar(slot);
+    if (schedule.kind != TimerSchedule::Repeat) return false;
+
+    qint64 period = timers.duration(slot).count();
+    if (period <= 0) return false;
+
+    // Наступний дедлайн відраховується від попереднього, а не від моменту обробки, — без накопичення дрейфу.
+    // Пропущені за час простою повтори не наздоганяються
+    qint64 now = timers.clockNow(slot, timers.nowMs());
+    qint64 next = timers.deadline(slot) + period;
+    if (next <= now) next += ((now - next) / period + 1) * period;
+    placeOnWheel(slot, next);
+    return true;
+}
+
+void TimerManager::setWakeupSlack(int ms)
+{
+    ms = qMax(0, ms);
+    if (ms == slackMs) return;
+    slackMs = ms;
+    rescheduleDriver();
+}
+
+void TimerManager::startDriver(ClockTimer &timer, qint64 delay) const
+{
+    // Пробудження вирівнюються вгору на спільну сітку — усі драйвери прокидаються в ті самі моменти
+    if (slackMs > 0) {
+        qint64 now = timers.nowMs();
+        qint64 wake = now + qMax<qint64>(0, delay);
+        wake = (wake + slackMs - 1) / slackMs * slackMs;
+        delay = wake - now;
+    }
+
+    // Короткі дедлайни — точним таймером. Довге очікування — грубим, що дозволяє ОС групувати пробудження;
+    // груба похибка сягає 5%, тож він будиться на 10% раніше, а останній відрізок добирає вже точний
+    if (delay <= PreciseThresholdMs) {
+        timer.setTimerType(Qt::PreciseTimer);
+    } else {
+        timer.setTimerType(Qt::CoarseTimer);
+        delay = delay * 9 / 10;
+    }
+    timer.start(int(qMin<qint64>(delay, INT_MAX)));
+}
+
+void TimerManager::rescheduleDriver()
+{
+    // Купу розкладів перевіряємо не рідше ніж щохвилини: настінний годинник можуть перевести
+    if (calendar.isEmpty()) {
+        calendarDriver.stop();
+    } else {
+        qint64 delay = calendar.topKey() - timers.clock()->wallMs();
+        startDriver(calendarDriver, qBound<qint64>(0, delay, 60000));
+    }
+
+    // Групи перебираються цілком, але їх мало; група на паузі драйвер не будить
+    qint64 groupDelay = -1;
+    qint64 now = timers.nowMs();
+    for (auto it = groupDue.constBegin(); it != groupDue.constEnd(); ++it) {
+        if (it->empty() || !timers.clocks().isRunning(it.key())) continue;
+        qint64 delay = it->begin()->first - timers.clocks().time(it.key(), now);
+        if (groupDelay < 0 || delay < groupDelay) groupDelay = qMax<qint64>(0, delay);
+    }
+    if (groupDelay < 0) groupDriver.stop();
+    else startDriver(groupDriver, groupDelay);
+
+    // У потоковому режимі досить розбудити рушій — одне пробудження на пачку команд
+    if (engine) {
+        engine->wake();
+        return;
+    }
+
+    if (wheel.isEmpty()) {
+        driver.stop();
+        return;
+    }
+
+    TimingWheel::Tick next = wheel.nextEventTick();
+    TimingWheel::Tick tick = nowTick();
+    startDriver(driver, qint64(next > tick ? next - tick : 0));
+}
+
+bool TimerManager::updateTimer(int id, const QString &newName, TimerDuration newDuration)
+{
+    int slot = slotOf(id);
+    if (slot < 0)
         return false;
+    // Те саме правило, що й в addTimers: лише таймеру за розкладом тривалість не потрібна
+    if (!isCalendar(slot) && newDuration <= TimerDuration::zero())
+        return false;
+
+    if (timers.isRunning(slot)) {
+        disarm(slot);
+        rescheduleDriver();
+    }
+
+    if (timers.name(slot) != newName) {
+        unindexName(id, timers.name(slot));
+        indexName(id, newName);
+        timers.setName(slot, newName);
+    }
+    timers.setDuration(slot, newDuration);
+    timers.setRemaining(slot, newDuration);
+    if (store) store->logUpdate(id, newName, newDuration);
+    if (history) {
+        history->recordName(id, newName);
+        history->record(TimerHistory::Edit, id);
+    }
 
-    t->running = false;
-    t->qtimer->stop();
-    emit timerUpdated(id, t->remainingSeconds, false);
+    notifyUpdated(id, TimerView(&timers, slot).remaining(), false);
     return true;
 }
 
-bool TimerManager::updateTimer(int id, const QString &newName, int newDurationSeconds)
+bool TimerManager::setSchedule(int id, const TimerSchedule &schedule)
 {
-    TimerEntry* t = getTimerById(id);
-    if (!t)
+    int slot = slotOf(id);
+    if (slot < 0)
+        return false;
+    if (schedule.kind == TimerSchedule::Calendar && (!schedule.cron.isValid() || timers.group(slot) != 0))
         return false;
 
-    bool wasRunning = t->running;
-    if (wasRunning) pauseTimer(id);
+    bool wasRunning = timers.isRunning(slot);
+    if (wasRunning) disarm(slot);
+    timers.setSchedule(slot, schedule);
+    if (store) store->logSchedule(id, schedule);
+
+    if (wasRunning && arm(slot)) logStart(slot);
+    rescheduleDriver();
+
+    notifyUpdated(id, TimerView(&timers, slot).remaining(), timers.isRunning(slot));
+    return true;
+}
 
-    t->name = newName;
-    t->durationSeconds = newDurationSeconds;
-    t->remainingSeconds = newDurationSeconds;
+bool TimerManager::setActions(int id, const QVector<TimerAction> &actions)
+{
+    int slot = slotOf(id);
+    if (slot < 0)
+        return false;
+    if (timers.actions(slot) == actions)
+        return true;
 
-    emit timerUpdated(id, t->remainingSeconds, false);
+    // Слот уже позначено зміненим — лишається опублікувати знімок, щоб читачі побачили нові дії
+    timers.setActions(slot, actions);
+    if (store) store->logActions(id, actions);
+    schedulePublish();
     return true;
 }
 
-QVector<TimerEntry> TimerManager::getAllTimers() const
+int TimerManager::addGroup(const QString &name, int parentGroup)
 {
-    return timers;
+    if (parentGroup != 0 && !timers.clocks().contains(parentGroup))
+        return 0;
+
+    int group = timers.clocks().create(name, parentGroup);
+    if (store) store->logGroup(groupState(group));
+    emit groupsChanged();
+    return group;
 }
 
-QList<TimerEntry*> TimerManager::getAllTimersPointers()
+bool TimerManager::removeGroup(int group)
 {
-    QList<TimerEntry*> list;
-    for (int i = 0; i < timers.size(); ++i) {
-        list.append(const_cast<TimerEntry*>(&timers[i]));
+    GroupClocks &clocks = timers.clocks();
+    if (!clocks.contains(group))
+        return false;
+
+    // Таймери переходять до батьківської групи зі своїм залишком, підгрупи — зі своїм часом
+    int parent = clocks.group(group).parent;
+    for (int id : timersInGroup(group)) setTimerGroup(id, parent);
+
+    qint64 now = timers.nowMs();
+    for (int child : clocks.ids()) {
+        if (clocks.group(child).parent != group) continue;
+        clocks.setParent(child, parent, now);
+        if (store) store->logGroup(groupState(child));
     }
-    return list;
+
+    clocks.remove(group);
+    groupDue.remove(group);
+    if (store) store->logGroupRemove(group);
+    rescheduleDriver();
+    emit groupsChanged();
+    return true;
 }
 
-bool TimerManager::isNameUnique(const QString &name, int excludeId) const
+bool TimerManager::renameGroup(int group, const QString &name)
+{
+    if (!timers.clocks().contains(group))
+        return false;
+
+    timers.clocks().rename(group, name);
+    if (store) store->logGroup(groupState(group));
+    emit groupsChanged();
+    return true;
+}
+
+bool TimerManager::pauseGroup(int group)
+{
+    if (!timers.clocks().contains(group)) return false;
+    QVector<int> ticking = runningInGroup(group, true);
+    if (!timers.clocks().pause(group, timers.nowMs()))
+        return false;
+    recordTicking(ticking, false);
+    groupClockChanged(group);
+    return true;
+}
+
+bool TimerManager::resumeGroup(int group)
+{
+    if (!timers.clocks().contains(group)) return false;
+    QVector<int> stopped = runningInGroup(group, false);
+    if (!timers.clocks().resume(group, timers.nowMs()))
+        return false;
+    recordTicking(stopped, true);
+    groupClockChanged(group);
+    return true;
+}
+
+// Запущені таймери групи й підгруп, що зараз ідуть (ticking) або стоять через паузу годинника
+QVector<int> TimerManager::runningInGroup(int group, bool ticking) const
+{
+    QVector<int> slots;
+    if (!history) return slots;
+    for (int slot = 0; slot < timers.capacity(); ++slot) {
+        if (timers.isLive(slot) && timers.isRunning(slot) && timers.group(slot) != 0
+            && timers.isTicking(slot) == ticking && timers.clocks().isAncestor(group, timers.group(slot)))
+            slots.append(slot);
+    }
+    return slots;
+}
+
+// В історії запуск триває, лише поки таймер справді йде: пауза годинника групи його закриває,
+// продовження — відкриває новий. Зсув годинника ходу не змінює і в історію не пишеться
+void TimerManager::recordTicking(const QVector<int> &slots, bool ticking)
 {
-    for (const auto &t : timers) {
-        if (t.id != excludeId && t.name == name) {
-            return false;
+    for (int slot : slots) {
+        if (timers.isTicking(slot) == ticking)
+            history->record(ticking ? TimerHistory::Start : TimerHistory::Pause, timers.id(slot));
+    }
+}
+
+bool TimerManager::shiftGroup(int group, TimerDuration delta)
+{
+    if (!timers.clocks().contains(group))
+        return false;
+    timers.clocks().shift(group, delta.count());
+    groupClockChanged(group);
+    return true;
+}
+
+void TimerManager::groupClockChanged(int group)
+{
+    // Дедлайни таймерів лишились тими самими, змінився лише годинник: порядок спрацювання
+    // перебудується при наступному запиті, а в журнал пишуться сама група і її підгрупи
+    if (expiryOrderBuilt) {
+        expiryOrder.clear();
+        expiryOrderBuilt = false;
+    }
+    if (store) {
+        for (int g : timers.clocks().ids()) {
+            if (timers.clocks().isAncestor(group, g)) store->logGroup(groupState(g));
         }
     }
+    rescheduleDriver();
+    emit groupsChanged();
+}
+
+bool TimerManager::setTimerGroup(int id, int group)
+{
+    int slot = slotOf(id);
+    if (slot < 0 || (group != 0 && (!timers.clocks().contains(group) || isCalendar(slot))))
+        return false;
+    if (timers.group(slot) == group)
+        return true;
+
+    // Залишок переноситься з годинника старої групи на годинник нової
+    bool wasRunning = timers.isRunning(slot);
+    bool wasTicking = timers.isTicking(slot);
+    if (wasRunning) disarm(slot);
+    timers.setGroup(slot, group);
+    if (store) store->logMember(id, group);
+    if (wasRunning && arm(slot)) logStart(slot);
+    if (history && timers.isTicking(slot) != wasTicking)
+        history->record(wasTicking ? TimerHistory::Pause : TimerHistory::Start, id);
+    rescheduleDriver();
+
+    notifyUpdated(id, TimerView(&timers, slot).remaining(), timers.isRunning(slot));
     return true;
 }
 
+QVector<int> TimerManager::timersInGroup(int group) const
+{
+    QVector<int> ids;
+    for (int slot = 0; slot < timers.capacity(); ++slot) {
+        if (timers.isLive(slot) && timers.group(slot) == group) ids.append(timers.id(slot));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+StoredGroup TimerManager::groupState(int group) const
+{
+    const GroupClocks &clocks = timers.clocks();
+    const GroupClocks::Group &g = clocks.group(group);
+    qint64 now = timers.nowMs();
+    return StoredGroup{group, g.parent, g.name, g.paused, clocks.isRunning(group), clocks.time(group, now) - now};
+}
+
+QVector<StoredGroup> TimerManager::groupStates() const
+{
+    QVector<StoredGroup> list;
+    for (int group : timers.clocks().ids()) list.append(groupState(group));
+    return list;
+}
+
+void TimerManager::restoreGroups(const QVector<StoredGroup> &list)
+{
+    qint64 now = timers.nowMs();
+    for (const StoredGroup &g : list)
+        timers.clocks().restore(g.id, g.name, g.parent, g.paused, now, now + g.skewMs);
+}
+
+void TimerManager::attachHistory(TimerHistory *history)
+{
+    this->history = history;
+    if (!history) return;
+    history->setClock(timers.clock());
+
+    // Історія пам'ятає запуски, що тривали на момент виходу. Те, що сталося далі без програми, дописуємо:
+    // спрацювання — на час дедлайну, решта (таймер на паузі чи його вже немає) — зараз
+    QSet<int> open;
+    for (int id : history->openRunIds()) {
+        open.insert(id);
+        int slot = slotOf(id);
+        if (slot < 0) history->record(TimerHistory::Remove, id);
+        else if (timers.isTicking(slot)) continue;
+        else if (expiredOnRestore.contains(id)) history->recordAt(TimerHistory::Finish, id, expiredOnRestore.value(id));
+        else history->record(TimerHistory::Pause, id);
+    }
+    expiredOnRestore.clear();
+
+    // Назви пишуться лише ті, яких історія ще не бачила; запущені таймери без відкритого запуску
+    // (історія новіша за них або запуск старший за два місяці) рахуються з цього моменту
+    for (int slot = 0; slot < timers.capacity(); ++slot) {
+        if (!timers.isLive(slot)) continue;
+        int id = timers.id(slot);
+        history->recordName(id, timers.name(slot));
+        if (timers.isTicking(slot) && !open.contains(id)) history->record(TimerHistory::Start, id);
+    }
+}
+
+void TimerManager::logStart(int slot)
+{
+    if (!store) return;
+    qint64 now = timers.nowMs();
+    store->logStart(timers.id(slot), timers.remainingNow(slot, now).count(), timers.clockNow(slot, now) - now);
+}
+
+// Слоти перевикористовуються, тож порядок додавання відновлюємо за id
+QVector<int> TimerManager::timerIds() const
+{
+    QVector<int> ids;
+    ids.reserve(timers.size());
+    for (int id = 1; id < slotById.size(); ++id) {
+        if (slotById[id] >= 0) ids.append(id);
+    }
+    return ids;
+}
+
+TimerRecord TimerManager::recordOf(int slot) const
+{
+    TimerRecord r;
+    r.id = timers.id(slot);
+    r.name = timers.name(slot);
+    r.duration = timers.duration(slot);
+    r.remainingMs = timers.remaining(slot).count();
+    r.deadline = timers.deadline(slot);
+    r.running = timers.isRunning(slot);
+    r.group = timers.group(slot);
+    r.schedule = timers.schedule(slot);
+    r.actions = timers.actions(slot);
+    return r;
+}
+
+TimerSnapshot TimerManager::snapshot()
+{
+    bool changed = clocksChanged;
+    published.records.resize(qMax(published.records.size(), nextId));
+
+    if (!timers.isTracking()) {
+        timers.setTracking(true);
+        published.live = 0;
+        for (int slot = 0; slot < timers.capacity(); ++slot) {
+            if (!timers.isLive(slot)) continue;
+            published.records.set(timers.id(slot), recordOf(slot));
+            ++published.live;
+        }
+        changed = true;
+    } else {
+        QVector<int> slots, removed;
+        timers.takeChanges(slots, removed);
+
+        // Спершу видалення: той самий id міг одразу з'явитися знову (копія сервера)
+        for (int id : removed) {
+            if (published.records.at(id).id != id) continue;
+            published.records.set(id, TimerRecord());
+            --published.live;
+        }
+        for (int slot : slots) {
+            if (!timers.isLive(slot)) continue;
+            int id = timers.id(slot);
+            if (published.records.at(id).id != id) ++published.live;
+            published.records.set(id, recordOf(slot));
+        }
+        changed |= !slots.isEmpty() || !removed.isEmpty();
+    }
+
+    if (changed || published.isNull()) {
+        clocksChanged = false;
+        published.clocks = timers.clocks();
+        published.timeSource = timers.clock();
+        ++published.publication;
+        std::atomic_store(&latest, std::make_shared<const TimerSnapshot>(published));
+    }
+    return published;
+}
+
+TimerSnapshot TimerManager::latestSnapshot() const
+{
+    std::shared_ptr<const TimerSnapshot> current = std::atomic_load(&latest);
+    return current ? *current : TimerSnapshot();
+}
+
+// Публікація для інших потоків іде разом зі зведеним сповіщенням
+void TimerManager::schedulePublish()
+{
+    if (timers.isTracking() && !notifyTimer.isActive()) notifyTimer.start();
+}
+
+// У компактному режимі замість хешу назв — відбитки назв; збіг відбитка перевіряється назвою з арени
+void TimerManager::indexName(int id, const QString &name)
+{
+    if (timers.isCompact()) fingerprints.insert(name, id);
+    else idByName.insert(name, id);
+    if (nameIndexBuilt) nameIndex.insert(id, name);
+}
+
+void TimerManager::unindexName(int id, const QString &name)
+{
+    if (timers.isCompact()) fingerprints.remove(name, id);
+    else idByName.remove(name, id);
+    if (nameIndexBuilt) nameIndex.remove(id, name);
+}
+
+QVector<int> TimerManager::findTimers(const QString &query, int limit) const
+{
+    QVector<int> found;
+    if (query.isEmpty()) return found;
+
+    // Індекс будується при першому пошуку; далі він оновлюється разом з назвами
+    if (!nameIndexBuilt) {
+        for (int slot = 0; slot < timers.capacity(); ++slot) {
+            if (timers.isLive(slot)) nameIndex.insert(timers.id(slot), timers.name(slot));
+        }
+        nameIndexBuilt = true;
+    }
+
+    bool exact = false;
+    found = nameIndex.candidates(query, &exact);
+    if (!exact) {
+        found.erase(std::remove_if(found.begin(), found.end(), [&](int id) {
+            return !NameIndex::matches(timers.name(slotOf(id)), query);
+        }), found.end());
+    }
+
+    std::sort(found.begin(), found.end());
+    if (limit >= 0 && found.size() > limit) found.resize(limit);
+    return found;
+}
+
+void TimerManager::ensureExpiryOrder() const
+{
+    if (expiryOrderBuilt) return;
+    expiryOrderBuilt = true;
+    for (int slot = 0; slot < timers.capacity(); ++slot) {
+        if (timers.isLive(slot)) reorder(slot);
+    }
+}
+
+void TimerManager::reorder(int slot) const
+{
+    if (!expiryOrderBuilt) return;
+
+    // Дедлайн у часі групи переводиться в монотонний: поки годинник групи іде, зсув між ними сталий
+    qint64 now = timers.nowMs();
+    if (timers.isTicking(slot))
+        expiryOrder.setRunning(timers.id(slot), timers.deadline(slot) - (timers.clockNow(slot, now) - now));
+    else
+        expiryOrder.setPaused(timers.id(slot), timers.remainingNow(slot, now).count());
+}
+
+QVector<int> TimerManager::nextToExpire(int k) const
+{
+    ensureExpiryOrder();
+    return expiryOrder.nextToExpire(k);
+}
+
+QVector<int> TimerManager::timersBySoonest() const
+{
+    ensureExpiryOrder();
+    return expiryOrder.ordered();
+}
+
+bool TimerManager::isNameUnique(const QString &name, int excludeId) const
+{
+    if (timers.isCompact()) {
+        QByteArray utf8;
+        // Назву понад 0xFFFF байтів арена обрізає, тож її відбиток може пережити таймер
+        return !fingerprints.any(name, [&](int id) {
+            int slot = slotOf(id);
+            if (id == excludeId || slot < 0) return false;
+            if (utf8.isEmpty()) utf8 = name.toUtf8();
+            return timers.nameIsUtf8(slot, utf8);
+        });
+    }
+
+    int count = idByName.count(name);
+    if (count > 0 && idByName.contains(name, excludeId)) --count;
+    return count == 0;
+}
+
+TimerManager::MemoryUsage TimerManager::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.timers = timers.size();
+    usage.storage = timers.memoryBytes();
+
+    // Вузол QMultiHash тримає ключ і вказівник на ланцюжок значень; самі рядки спільні зі сховищем
+    usage.indexes = slotById.capacity() * qint64(sizeof(int))
+                    + idByName.capacity() * qint64(sizeof(QString) + sizeof(void*) + 1)
+                    + idByName.size() * qint64(sizeof(int) + sizeof(void*))
+                    + fingerprints.memoryBytes() + nameIndex.memoryBytes() + expiryOrder.memoryBytes();
+
+    usage.scheduling = wheel.memoryBytes() + calendar.memoryBytes();
+    for (const auto &due : groupDue)
+        usage.scheduling += qint64(due.size()) * (ExpiryOrder::TreeNodeBytes + sizeof(std::pair<qint64, int>));
+    return usage;
+}
+
 void TimerManager::handleTick()
 {
-    QTimer* senderTimer = qobject_cast<QTimer*>(sender());
-    if (!senderTimer) return;
+    // Пробудження лише на найближчий дедлайн (або каскад колеса) — запущені таймери тут не чіпаються
+    qint64 started = timerStats.elapsedUs();
+    QVector<int> expired;
+    TimingWheel::Tick now = nowTick();
+    wheel.advance(now, expired);
+
+    // Payload у колесі — індекс слоту; скасовані вузли з колеса вже прибрано, тож слот живий
+    recordLateness(expired, qint64(now));
+    finishTimers(expired);
+    timerStats.tickProcessing.record(timerStats.elapsedUs() - started);
+}
+
+void TimerManager::drainEngineEvents()
+{
+    if (!engine) return;
+
+    qint64 started = timerStats.elapsedUs();
+
+    // Подія могла застаріти: таймер поставили на паузу, видалили або перезапустили
+    QVector<int> expired;
+    EngineEvent ev;
+    while (engine->takeEvent(ev)) {
+        if (ev.slot >= timers.capacity() || !timers.isLive(ev.slot)) continue;
+        if (timers.isRunning(ev.slot) && timers.armSeq(ev.slot) == ev.seq) expired.append(ev.slot);
+    }
+
+    if (expired.isEmpty()) return;
 
-    for (auto &t : timers) {
-        if (t.qtimer == senderTimer) {
-            t.remainingSeconds -= 1;
+    // Запізнення міряємо до моменту обробки тут, а не до спрацювання в рушії: так воно включає доставку
+    recordLateness(expired, timers.nowMs());
+    finishTimers(expired);
+    timerStats.tickProcessing.record(timerStats.elapsedUs() - started);
+}
 
-            emit timerUpdated(t.id, t.remainingSeconds, t.running);
+void TimerManager::recordLateness(const QVector<int> &slotIndices, qint64 now)
+{
+    for (int slot : slotIndices)
+        timerStats.expiryLateness.record((now - timers.deadline(slot)) * 1000);
+}
+
+void TimerManager::handleCalendarTick()
+{
+    qint64 started = timerStats.elapsedUs();
+    qint64 wallNow = timers.clock()->wallMs();
 
-            if (t.remainingSeconds <= 0) {
-                t.qtimer->stop();
-                t.running = false;
-                emit timerFinished(t.id);
-            }
-            return;
+    QVector<int> due;
+    while (!calendar.isEmpty() && calendar.topKey() <= wallNow) {
+        timerStats.expiryLateness.record((wallNow - calendar.topKey()) * 1000);
+        due.append(calendar.topSlot());
+        calendar.pop();
+    }
+
+    if (due.isEmpty()) {
+        rescheduleDriver();
+        return;
+    }
+    finishTimers(due);
+    timerStats.tickProcessing.record(timerStats.elapsedUs() - started);
+}
+
+void TimerManager::handleGroupTick()
+{
+    qint64 started = timerStats.elapsedUs();
+    qint64 now = timers.nowMs();
+
+    QVector<int> due;
+    for (auto it = groupDue.begin(); it != groupDue.end(); ++it) {
+        if (it->empty() || !timers.clocks().isRunning(it.key())) continue;
+        qint64 clock = timers.clocks().time(it.key(), now);
+        while (!it->empty() && it->begin()->first <= clock) {
+            timerStats.expiryLateness.record((clock - it->begin()->first) * 1000);
+            due.append(it->begin()->second);
+            it->erase(it->begin());
+        }
+    }
+
+    if (due.isEmpty()) {
+        rescheduleDriver();
+        return;
+    }
+    finishTimers(due);
+    timerStats.tickProcessing.record(timerStats.elapsedUs() - started);
+}
+
+void TimerManager::finishTimers(const QVector<int> &slotIndices)
+{
+    QVector<int> finishedSlots;
+    finishedSlots.reserve(slotIndices.size());
+    for (int slot : slotIndices) {
+        timers.setWheelNode(slot, -1);
+
+        if (history) history->record(TimerHistory::Finish, timers.id(slot));
+
+        // Повторювані таймери одразу перевзводяться і лишаються запущеними
+        if (rearm(slot)) {
+            logStart(slot);
+            if (history) history->record(TimerHistory::Start, timers.id(slot));
+        } else {
+            timers.setRemaining(slot, TimerDuration::zero());
+            timers.setRunning(slot, false);
+            --runningTotal;
+            if (store) store->logPause(timers.id(slot), 0);
+        }
+        finishedSlots.append(slot);
+    }
+
+    rescheduleDriver();
+    timerStats.countExpirations(finishedSlots.size());
+
+    // Дії всіх спрацювань проходу — одним пакетом у пул диспетчера
+    QVector<ActionDispatcher::Job> jobs;
+    for (int slot : finishedSlots) {
+        const QVector<TimerAction> &actions = timers.actions(slot);
+        if (!actions.isEmpty()) jobs.append({timers.id(slot), timers.name(slot), actions});
+    }
+    if (!jobs.isEmpty()) dispatcher.dispatch(std::move(jobs));
+
+    for (int slot : finishedSlots) {
+        TimerView t(&timers, slot);
+        int id = t.id();
+        notifyUpdated(id, t.running() ? t.remaining() : TimerDuration::zero(), t.running());
+        emit timerFinished(id);
+    }
+}
+
+void TimerManager::setEngineThreadEnabled(bool enabled)
+{
+    if (enabled == (engine != nullptr)) return;
+    if (enabled && timers.clock()->simulated()) return;
+
+    if (enabled) {
+        engineThread = new QThread(this);
+        engine = new TimerEngine(this);
+        engine->moveToThread(engineThread);
+        connect(engineThread, &QThread::finished, engine, &QObject::deleteLater);
+        engineThread->start(QThread::TimeCriticalPriority);
+
+        // Запущені таймери переходять з локального колеса в рушій
+        driver.stop();
+        for (int slot = 0; slot < timers.capacity(); ++slot) {
+            if (!timers.isLive(slot) || !timers.isRunning(slot) || !onWheel(slot)) continue;
+            wheel.cancel(timers.wheelNode(slot));
+            timers.setWheelNode(slot, -1);
+            timers.setArmSeq(slot, ++armCounter);
+            engine->post({EngineCommand::Arm, slot, timers.armSeq(slot), TimingWheel::Tick(timers.deadline(slot))});
+        }
+        engine->wake();
+    } else {
+        engineThread->quit();
+        engineThread->wait();
+        delete engineThread;
+        engineThread = nullptr;
+        engine = nullptr;
+
+        // Невидані події рушія втрачаються разом з ним: дедлайни просто повертаються в локальне колесо
+        QVector<int> none;
+        wheel.advance(nowTick(), none);
+        for (int slot = 0; slot < timers.capacity(); ++slot) {
+            if (!timers.isLive(slot) || !timers.isRunning(slot) || !onWheel(slot)) continue;
+            timers.setWheelNode(slot, wheel.schedule(TimingWheel::Tick(timers.deadline(slot)), slot));
         }
+        rescheduleDriver();
     }
 }
+
+void TimerManager::notifyUpdated(int id, TimerDuration remaining, bool running)
+{
+    // Сюди приходить кожна зміна стану таймера — тут же оновлюється й порядок спрацювання
+    if (expiryOrderBuilt) {
+        int slot = slotOf(id);
+        if (slot >= 0) reorder(slot);
+    }
+
+    emit timerUpdated(id, remaining, running);
+
+    dirtyIds.insert(id);
+    if (!notifyTimer.isActive()) notifyTimer.start();
+}
+
+void TimerManager::flushUpdates()
+{
+    if (timers.isTracking()) snapshot();
+    if (dirtyIds.isEmpty()) return;
+
+    QVector<int> ids(dirtyIds.begin(), dirtyIds.end());
+    dirtyIds.clear();
+    timerStats.markUpdatesEmitted();
+    emit timersUpdated(ids);
+}
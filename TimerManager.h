@@ -3,17 +3,30 @@
 
 #include <QObject>
 #include <QVector>
-#include <QTimer>
 #include <QList>
+#include <QHash>
+#include <QMultiHash>
+#include <QSet>
+#include <set>
+#include <utility>
+#include "TimingWheel.h"
+#include "TimerStorage.h"
+#include "TimerStats.h"
+#include "ScheduleHeap.h"
+#include "NameIndex.h"
+#include "NameFingerprints.h"
+#include "ExpiryOrder.h"
+#include "Clock.h"
+#include "ActionDispatcher.h"
+#include "TimerSnapshot.h"
+#include <memory>
 
-struct TimerEntry {
-    int id;
-    QString name;
-    int durationSeconds;
-    int remainingSeconds;
-    bool running;
-    QTimer* qtimer;
-};
+class QThread;
+class TimerStore;
+class TimerHistory;
+class TimerEngine;
+struct StoredTimer;
+struct StoredGroup;
 
 class TimerManager : public QObject
 {
@@ -23,29 +36,255 @@ public:
     explicit TimerManager(QObject *parent = nullptr);
     ~TimerManager();
 
-    int addTimer(const QString &name, int durationSeconds);
+    // Джерело часу; змінюється лише поки таймерів немає. З SimulatedClock таймери спрацьовують
+    // під час його advance(), а потоковий режим недоступний. nullptr — системний годинник
+    void setClock(Clock *clock);
+    Clock *clock() const { return timers.clock(); }
+
+    int addTimer(const QString &name, TimerDuration duration, const TimerSchedule &schedule = TimerSchedule());
+
+    struct NewTimer {
+        QString name;
+        TimerDuration duration{0};
+        TimerSchedule schedule;
+    };
+
+    // Пакетне додавання: один резерв сховища, перевірка унікальності назв одним проходом і одне сповіщення
+    // timersAdded. Порожня чи вже зайнята назва (серед наявних або раніше в пачці), нульова тривалість
+    // таймера не за розкладом відхиляються — їхні позиції в list потрапляють у rejected. Повертає id доданих
+    QVector<int> addTimers(const QVector<NewTimer> &list, QVector<int> *rejected = nullptr);
+    // Потокове додавання частинами: між beginAdding і endAdding виклики addTimers не резервують і не сповіщають,
+    // резерв — один на expected таймерів, а endAdding надсилає одне timersAdded з усіма доданими
+    void beginAdding(int expected);
+    void endAdding();
     bool removeTimer(int id);
     bool startTimer(int id);
     bool pauseTimer(int id);
-    bool updateTimer(int id, const QString &newName, int newDurationSeconds);
+    // Тривалість таймера не за розкладом cron має бути додатною — інакше false і таймер не змінюється
+    bool updateTimer(int id, const QString &newName, TimerDuration newDuration);
+
+    // Повторення після спрацювання: Repeat — з періодом, рівним тривалості; Calendar — за розкладом cron.
+    // Запущений таймер перевзводиться вже за новим розкладом
+    bool setSchedule(int id, const TimerSchedule &schedule);
+
+    // Пакетні операції: один прохід, одне перепланування драйвера, одне зведене сповіщення.
+    // Повертають кількість таймерів, яких операція справді торкнулась.
+    int startTimers(const QList<int> &ids);
+    int pauseTimers(const QList<int> &ids);
+    int removeTimers(const QList<int> &ids);
+    int resetTimers(const QList<int> &ids);
+
+    // Групи таймерів з віртуальними годинниками, можуть бути вкладеними. Пауза, продовження і зсув
+    // групи — одна операція над її годинником, незалежно від кількості таймерів у ній.
+    // addGroup повертає id групи або 0
+    int addGroup(const QString &name, int parentGroup = 0);
+    bool removeGroup(int group);        // таймери і підгрупи переходять до батьківської групи
+    bool renameGroup(int group, const QString &name);
+    bool pauseGroup(int group);
+    bool resumeGroup(int group);
+    bool shiftGroup(int group, TimerDuration delta);    // додатний зсув наближає спрацювання
+
+    // 0 — вийняти з групи. Таймер за розкладом живе за настінним годинником і в групу не входить
+    bool setTimerGroup(int id, int group);
+
+    // Дії при спрацюванні; виконуються в пулі потоків диспетчера, порожній список — без дій
+    bool setActions(int id, const QVector<TimerAction> &actions);
+    ActionDispatcher &actionDispatcher() { return dispatcher; }
+
+    const GroupClocks &groups() const { return timers.clocks(); }
+    QVector<int> timersInGroup(int group) const;
+    QVector<StoredGroup> groupStates() const;
+    void restoreGroups(const QVector<StoredGroup> &list);
+
+    // id усіх таймерів за зростанням
+    QVector<int> timerIds() const;
 
-    QVector<TimerEntry> getAllTimers() const;
-    QList<TimerEntry*> getAllTimersPointers();
+    // Незмінний знімок усіх таймерів, який можна тримати скільки завгодно і читати з будь-якого потоку.
+    // Перший виклик будує знімок повністю і вмикає облік змін; далі публікація коштує O(змін з попередньої).
+    // Лише з потоку менеджера
+    TimerSnapshot snapshot();
+
+    // Останній опублікований знімок — з будь-якого потоку, без блокувань. Після першого snapshot()
+    // менеджер публікує новий разом зі зведеним сповіщенням; до нього — порожній знімок
+    TimerSnapshot latestSnapshot() const;
 
     bool isNameUnique(const QString &name, int excludeId = -1) const;
 
-    TimerEntry* getTimerById(int id);
+    // Пошук за підрядком назви без урахування регістру; id у порядку додавання.
+    // limit < 0 — без обмеження
+    QVector<int> findTimers(const QString &query, int limit = -1) const;
+
+    // До k запущених таймерів, що спрацюють найближчими, за зростанням дедлайну
+    QVector<int> nextToExpire(int k) const;
+
+    // Усі таймери "спершу найближчі": запущені за дедлайном, далі на паузі за залишком
+    QVector<int> timersBySoonest() const;
+
+    TimerView getTimerById(int id) const;
+
+    // Дескриптор з перевіркою покоління: після видалення таймера get() поверне недійсне подання
+    SlotHandle handleOf(int id) const;
+    TimerView get(SlotHandle handle) const
+    {
+        return timers.contains(handle) ? TimerView(&timers, handle.index) : TimerView();
+    }
+
+    // Пряме читання масивів сховища для швидких проходів
+    const TimerStorage &storage() const { return timers; }
+
+    // Оцінка пам'яті за складовими, у байтах
+    struct MemoryUsage {
+        int timers = 0;
+        qint64 storage = 0;     // масиви сховища, назви, розріджені поля
+        qint64 indexes = 0;     // id -> слот, назва -> id, пошук, порядок спрацювання
+        qint64 scheduling = 0;  // колесо, купа розкладів, черги груп
+
+        qint64 total() const { return storage + indexes + scheduling; }
+        double bytesPerTimer() const { return timers > 0 ? double(total()) / timers : 0.0; }
+    };
+    MemoryUsage memoryUsage() const;
+
+    // Компактний режим сховища (назви в арені, замість хешу назв — хеш їхніх відбитків) — лише поки таймерів ще не було
+    void setCompactMode(bool compact);
+    bool isCompactMode() const { return timers.isCompact(); }
+
+    int runningCount() const { return runningTotal; }
+    int count() const { return timers.size(); }
+    int peekNextId() const { return nextId; }
+
+    // Масове відновлення зі сховища; викликається до підключення моделей, сигналів не шле
+    void restoreTimers(const QVector<StoredTimer> &list, int nextId);
+
+    // Застосовує стан таймера з іншого процесу (копія сервера): створює таймер з тим самим id
+    // або оновлює наявний. Запущеним таймер вважається, якщо wallDeadlineMs != 0
+    void mirrorTimer(const StoredTimer &state);
+
+    // Після підключення кожна зміна стану дописується в журнал сховища
+    void attachStore(TimerStore *store) { this->store = store; }
+    // Після підключення старти, паузи, редагування, спрацювання й видалення пишуться в історію;
+    // запуск у ній триває, лише поки таймер справді йде — пауза годинника його групи теж його закриває
+    void attachHistory(TimerHistory *history);
+
+    // Необов'язковий режим: планування в окремому потоці, незалежно від навантаження GUI
+    void setEngineThreadEnabled(bool enabled);
+    bool isEngineThreadEnabled() const { return engine != nullptr; }
+
+    // Пакетні сповіщення: timersUpdated шлеться не частіше ніж раз на інтервал (мс)
+    void setUpdateInterval(int ms) { notifyTimer.setInterval(ms); }
+    int updateInterval() const { return notifyTimer.interval(); }
+
+    // Об'єднання пробуджень: драйвери будяться лише на межах сітки з кроком slack (мс), тож таймери,
+    // що спливають у межах одного кроку, спрацьовують за одне пробудження, із запізненням до slack.
+    // 0 — без об'єднання. У потоковому режимі не діє: рушій планує сам
+    void setWakeupSlack(int ms);
+    int wakeupSlack() const { return slackMs; }
+
+    // Інструментація: запізнення спрацювань, час обробки тіку, затримка до перемальовування
+    TimerStats &stats() { return timerStats; }
 
 signals:
-    void timerUpdated(int id, int remainingSeconds, bool running);
+    void timerAdded(int id);
+    void timersAdded(const QVector<int> &ids);     // пакет з addTimers замість timerAdded на кожен
+    void timersRemoved(const QVector<int> &ids);
+    void timerUpdated(int id, TimerDuration remaining, bool running);
     void timerFinished(int id);
 
+    // Зведене сповіщення про всі змінені таймери за один кадр
+    void timersUpdated(const QVector<int> &ids);
+
+    // Змінились групи або їхні годинники (пауза, продовження, зсув)
+    void groupsChanged();
+
 private slots:
     void handleTick();
+    void flushUpdates();
+    void drainEngineEvents();
+    void handleCalendarTick();
+    void handleGroupTick();
 
 private:
     int nextId;
-    QVector<TimerEntry> timers;
+    TimerStorage timers;
+    QVector<int> slotById;          // id -> слот (-1 — немає); id видаються щільно, з 1
+    QMultiHash<QString, int> idByName;  // лише у звичайному режимі
+    NameFingerprints fingerprints;      // лише в компактному
+    bool adding = false;
+    QVector<int> addedIds;          // додані між beginAdding і endAdding
+
+    // Індекс n-грам для пошуку; поки пошуком не користувались, його не ведуть
+    mutable NameIndex nameIndex;
+    mutable bool nameIndexBuilt = false;
+
+    // Порядок спрацювання; як і індекс назв, ведеться з першого запиту
+    mutable ExpiryOrder expiryOrder;
+    mutable bool expiryOrderBuilt = false;
+
+    // Один таймер-драйвер на всі записи; він прокидається лише на найближчий дедлайн
+    ClockTimer driver;
+    TimingWheel wheel;
+    int runningTotal;
+
+    // Таймери за розкладом чекають у купі за настінним годинником з окремим драйвером:
+    // переведення годинника чи сон системи не зсувають спрацювання на наступну хвилину розкладу
+    ScheduleHeap calendar;
+    ClockTimer calendarDriver;
+
+    // Таймери груп чекають у впорядкованих множинах (дедлайн у часі групи, слот) зі спільним драйвером,
+    // що прокидається на найближчий дедлайн серед груп, годинник яких іде
+    QHash<int, std::set<std::pair<qint64, int>>> groupDue;
+    ClockTimer groupDriver;
+
+    ClockTimer notifyTimer;
+    QSet<int> dirtyIds;
+
+    TimerStore *store;
+    TimerHistory *history = nullptr;
+    QHash<int, qint64> expiredOnRestore;    // id → дедлайн, що минув до запуску; для узгодження історії
+
+    QThread *engineThread;
+    TimerEngine *engine;
+    quint32 armCounter;
+
+    static constexpr TimingWheel::Tick PreciseThresholdMs = 5000;
+    int slackMs = 0;
+
+    TimerStats timerStats;
+    ActionDispatcher dispatcher;
+
+    // Робоча копія останнього знімка (вузли, створені після останньої публікації, змінюються на місці)
+    // і сама публікація для інших потоків, що підміняється атомарно
+    TimerSnapshot published;
+    std::shared_ptr<const TimerSnapshot> latest;
+    bool clocksChanged = false;
+
+    TimerRecord recordOf(int slot) const;
+    void schedulePublish();
+    void reserveFor(int count);
+
+    TimingWheel::Tick nowTick() const;
+    int slotOf(int id) const;
+    void bindId(int id, int slot);
+    bool arm(int slot);
+    void disarm(int slot);
+    void placeOnWheel(int slot, qint64 deadline);
+    bool armCalendar(int slot);
+    bool rearm(int slot);
+    bool isCalendar(int slot) const { return timers.schedule(slot).kind == TimerSchedule::Calendar; }
+    bool onWheel(int slot) const { return !isCalendar(slot) && timers.group(slot) == 0; }
+    void startDriver(ClockTimer &timer, qint64 delay) const;
+    void rescheduleDriver();
+    void finishTimers(const QVector<int> &slotIndices);
+    void recordLateness(const QVector<int> &slotIndices, qint64 now);
+    void notifyUpdated(int id, TimerDuration remaining, bool running);
+    void indexName(int id, const QString &name);
+    void unindexName(int id, const QString &name);
+    void ensureExpiryOrder() const;
+    void reorder(int slot) const;
+    void logStart(int slot);
+    StoredGroup groupState(int group) const;
+    void groupClockChanged(int group);
+    QVector<int> runningInGroup(int group, bool ticking) const;
+    void recordTicking(const QVector<int> &slots, bool ticking);
 };
 
 #endif // TIMERMANAGER_H
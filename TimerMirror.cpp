@@ -0,0 +1,54 @@
+#include "TimerMirror.h"
+#include "TimerClient.h"
+#include "TimerManager.h"
+
+TimerMirror::TimerMirror(TimerClient *client, TimerManager *replica, QObject *parent)
+    : QObject(parent), client(client), replica(replica)
+{
+    connect(client, &TimerClient::eventsReceived, this, &TimerMirror::onEvents);
+}
+
+bool TimerMirror::attach(int timeoutMs)
+{
+    // Підписка йде в тому ж запиті, що й знімок, тож між ними не губиться жодна подія
+    TimerClient::Batch batch;
+    batch.subscribe(Ipc::SubscribeFinished | Ipc::SubscribeChanges);
+    batch.queryAll();
+
+    // exec() крутить вкладений цикл подій, тож події можуть надійти ще до відповіді зі знімком
+    QVector<Ipc::Result> results;
+    attaching = true;
+    bool ok = client->exec(batch, &results, timeoutMs) && results.size() == 2;
+    attaching = false;
+    QVector<Ipc::Event> pending;
+    pending.swap(deferred);
+    if (!ok) return false;
+
+    for (const StoredTimer &t : results[1].timers) replica->mirrorTimer(t);
+    apply(pending);
+    return true;
+}
+
+void TimerMirror::onEvents(const QVector<Ipc::Event> &events)
+{
+    if (attaching) deferred += events;
+    else apply(events);
+}
+
+void TimerMirror::apply(const QVector<Ipc::Event> &events)
+{
+    QList<int> removed;
+    for (const Ipc::Event &ev : events) {
+        if (ev.type == Ipc::EventRemoved) {
+            removed.append(ev.timer.id);
+            continue;
+        }
+        // Видалення з тієї ж пачки застосовуємо до наступних оновлень, щоб зберегти порядок
+        if (!removed.isEmpty()) {
+            replica->removeTimers(removed);
+            removed.clear();
+        }
+        replica->mirrorTimer(ev.timer);
+    }
+    if (!removed.isEmpty()) replica->removeTimers(removed);
+}
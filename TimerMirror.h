@@ -0,0 +1,36 @@
+#ifndef TIMERMIRROR_H
+#define TIMERMIRROR_H
+
+#include <QObject>
+#include "IpcProtocol.h"
+
+class TimerClient;
+class TimerManager;
+
+// Локальна копія таймерів віддаленого сервера: модель і таблиця працюють з нею як із звичайним менеджером,
+// а зміни надходять потоком подій. Команди користувача йдуть на сервер через TimerClient.
+class TimerMirror : public QObject
+{
+    Q_OBJECT
+
+public:
+    TimerMirror(TimerClient *client, TimerManager *replica, QObject *parent = nullptr);
+
+    // Підписується на події і завантажує поточний стан сервера (синхронно)
+    bool attach(int timeoutMs = 30000);
+
+private slots:
+    void onEvents(const QVector<Ipc::Event> &events);
+
+private:
+    TimerClient *client;
+    TimerManager *replica;
+
+    // Події, що прийшли під час attach() раніше за знімок, відкладаються й застосовуються після нього
+    bool attaching = false;
+    QVector<Ipc::Event> deferred;
+
+    void apply(const QVector<Ipc::Event> &events);
+};
+
+#endif // TIMERMIRROR_H
@@ -0,0 +1,149 @@
+#include "TimerSchedule.h"
+#include <QRegularExpression>
+#include <QStringList>
+
+namespace {
+
+// Розбирає одне поле cron у бітову маску; false — якщо поле некоректне
+bool parseField(const QString &field, int lo, int hi, quint64 &mask)
+{
+    mask = 0;
+    for (const QString &part : field.split(',')) {
+        QString range = part;
+        int step = 1;
+        int slash = part.indexOf('/');
+        if (slash >= 0) {
+            bool ok;
+            step = part.mid(slash + 1).toInt(&ok);
+            if (!ok || step <= 0) return false;
+            range = part.left(slash);
+        }
+
+        int from, to;
+        if (range == "*") {
+            from = lo;
+            to = hi;
+        } else {
+            int dash = range.indexOf('-');
+            bool ok1, ok2 = true;
+            from = range.left(dash < 0 ? range.size() : dash).toInt(&ok1);
+            to = dash < 0 ? (slash >= 0 ? hi : from) : range.mid(dash + 1).toInt(&ok2);
+            if (!ok1 || !ok2 || from < lo || to > hi || from > to) return false;
+        }
+
+        for (int v = from; v <= to; v += step) mask |= quint64(1) << v;
+    }
+    return mask != 0;
+}
+
+} // namespace
+
+CronSchedule CronSchedule::parse(const QString &expression, QString *error)
+{
+    CronSchedule c;
+    QString expr = expression.trimmed();
+    c.text = expr;
+
+    if (expr == "@hourly") expr = "0 * * * *";
+    else if (expr == "@daily" || expr == "@midnight") expr = "0 0 * * *";
+    else if (expr == "@weekly") expr = "0 0 * * 0";
+    else if (expr == "@monthly") expr = "0 0 1 * *";
+
+    // "ГГ:ХХ" — щодня о вказаній порі
+    static const QRegularExpression dailyAt("^(\\d{1,2}):(\\d{2})$");
+    QRegularExpressionMatch m = dailyAt.match(expr);
+    if (m.hasMatch()) expr = QString("%1 %2 * * *").arg(m.captured(2).toInt()).arg(m.captured(1).toInt());
+
+    QStringList fields = expr.split(' ', Qt::SkipEmptyParts);
+    if (fields.size() != 5) {
+        if (error) *error = "Очікується 5 полів: хвилини години день місяць день_тижня";
+        return c;
+    }
+
+    quint64 mins, hrs, dom, mon, dow;
+    if (!parseField(fields[0], 0, 59, mins) || !parseField(fields[1], 0, 23, hrs)
+        || !parseField(fields[2], 1, 31, dom) || !parseField(fields[3], 1, 12, mon)
+        || !parseField(fields[4], 0, 7, dow)) {
+        if (error) *error = "Некоректне поле розкладу";
+        return c;
+    }
+
+    c.minutes = mins;
+    c.hours = quint32(hrs);
+    c.days = quint32(dom);
+    c.months = quint16(mon);
+    c.weekdays = quint8((dow | (dow >> 7)) & 0x7F);   // 7 — теж неділя
+    c.anyDay = fields[2] == "*";
+    c.anyWeekday = fields[4] == "*";
+    c.valid = true;
+    return c;
+}
+
+bool CronSchedule::dayMatches(const QDate &date) const
+{
+    bool dayOk = days & (quint32(1) << date.day());
+    bool weekdayOk = weekdays & (1 << (date.dayOfWeek() % 7));
+
+    // Як у cron: якщо обмежено обидва поля, досить збігу будь-якого з них
+    if (!anyDay && !anyWeekday) return dayOk || weekdayOk;
+    return dayOk && weekdayOk;
+}
+
+QDateTime CronSchedule::nextAfter(const QDateTime &from) const
+{
+    if (!valid) return QDateTime();
+
+    QDateTime local = from.toLocalTime();
+    QDate date = local.date();
+    int hour = local.time().hour();
+    int minute = local.time().minute() + 1;
+
+    // Кожен крок перескакує одразу на наступний місяць / день / годину / хвилину, тож циклів небагато.
+    // Межа в 5 років відсікає розклади на кшталт "31 лютого", що ніколи не настають
+    const QDate limit = date.addYears(5);
+    while (date <= limit) {
+        if (!(months & (1 << date.month()))) {
+            date = QDate(date.year(), date.month(), 1).addMonths(1);
+            hour = 0;
+            minute = 0;
+            continue;
+        }
+        if (!dayMatches(date)) {
+            date = date.addDays(1);
+            hour = 0;
+            minute = 0;
+            continue;
+        }
+
+        while (hour < 24 && !(hours & (quint32(1) << hour))) {
+            ++hour;
+            minute = 0;
+        }
+        while (hour < 24) {
+            while (minute < 60 && !(minutes & (quint64(1) << minute))) ++minute;
+            if (minute < 60) {
+                QDateTime candidate(date, QTime(hour, minute));
+                // Хвилина, що випала на перехід на літній час, не існує — шукаємо далі.
+                // Залежно від версії Qt така дата або недійсна, або зсунута на годину вперед
+                if (candidate.isValid() && candidate.time() == QTime(hour, minute) && candidate > local) return candidate;
+                ++minute;
+                continue;
+            }
+            do {
+                ++hour;
+            } while (hour < 24 && !(hours & (quint32(1) << hour)));
+            minute = 0;
+        }
+
+        date = date.addDays(1);
+        hour = 0;
+        minute = 0;
+    }
+    return QDateTime();
+}
+
+qint64 CronSchedule::nextAfterMs(qint64 wallMs) const
+{
+    QDateTime next = nextAfter(QDateTime::fromMSecsSinceEpoch(wallMs));
+    return next.isValid() ? next.toMSecsSinceEpoch() : -1;
+}
@@ -0,0 +1,59 @@
+#ifndef TIMERSCHEDULE_H
+#define TIMERSCHEDULE_H
+
+#include <QDateTime>
+#include <QString>
+#include <QtGlobal>
+
+// Розклад за настінним годинником у стилі cron: "хв год день місяць день_тижня".
+// Поля приймають *, списки (1,15), діапазони (1-5) і кроки (*/10, 8-18/2); день тижня 0–7, неділя — 0 або 7.
+// Також приймаються скорочення @hourly, @daily, @weekly, @monthly і просто "ГГ:ХХ" — щодня о цій порі.
+class CronSchedule
+{
+public:
+    CronSchedule() = default;
+
+    static CronSchedule parse(const QString &expression, QString *error = nullptr);
+
+    bool isValid() const { return valid; }
+    QString expression() const { return text; }
+
+    // Наступна відповідна хвилина строго після from (місцевий час); недійсний QDateTime — якщо такої немає
+    QDateTime nextAfter(const QDateTime &from) const;
+    // Те саме в мс від епохи; -1 — якщо такої немає
+    qint64 nextAfterMs(qint64 wallMs) const;
+
+private:
+    quint64 minutes = 0;    // біти 0..59
+    quint32 hours = 0;      // біти 0..23
+    quint32 days = 0;       // біти 1..31
+    quint16 months = 0;     // біти 1..12
+    quint8 weekdays = 0;    // біти 0..6, 0 — неділя
+    bool anyDay = true;     // поле дня місяця — "*"
+    bool anyWeekday = true; // поле дня тижня — "*"
+    bool valid = false;
+    QString text;
+
+    bool dayMatches(const QDate &date) const;
+};
+
+// Як таймер поводиться після спрацювання
+struct TimerSchedule
+{
+    enum Kind : quint8 {
+        Once,       // звичайний відлік: зупиняється на нулі
+        Repeat,     // перезапускається з тим самим періодом (тривалістю таймера)
+        Calendar    // спрацьовує за розкладом cron за настінним годинником
+    };
+
+    Kind kind = Once;
+    CronSchedule cron;
+
+    bool isRecurring() const { return kind != Once; }
+
+    static TimerSchedule once() { return TimerSchedule(); }
+    static TimerSchedule repeat() { TimerSchedule s; s.kind = Repeat; return s; }
+    static TimerSchedule calendar(const CronSchedule &cron) { TimerSchedule s; s.kind = Calendar; s.cron = cron; return s; }
+};
+
+#endif // TIMERSCHEDULE_H
@@ -0,0 +1,275 @@
+#include "TimerServer.h"
+#include "TimerManager.h"
+#include <QLocalSocket>
+
+using namespace BinaryCodec;
+
+namespace {
+
+// Команда запиту після розбору
+struct Command {
+    quint8 op = 0;
+    qint32 id = -1;
+    QString name;
+    qint64 durationMs = 0;
+    TimerSchedule schedule;
+    quint8 mask = 0;
+};
+
+bool isBulk(quint8 op)
+{
+    return op == Ipc::CmdStart || op == Ipc::CmdPause || op == Ipc::CmdRemove || op == Ipc::CmdReset;
+}
+
+bool parseCommand(Reader &r, Command &c)
+{
+    if (!r.get(c.op)) return false;
+    switch (c.op) {
+    case Ipc::CmdAdd:
+        return r.getString(c.name) && r.get(c.durationMs) && r.getSchedule(c.schedule);
+    case Ipc::CmdStart:
+    case Ipc::CmdPause:
+    case Ipc::CmdRemove:
+    case Ipc::CmdReset:
+    case Ipc::CmdQuery:
+        return r.get(c.id);
+    case Ipc::CmdUpdate:
+        return r.get(c.id) && r.getString(c.name) && r.get(c.durationMs);
+    case Ipc::CmdSetSchedule:
+        return r.get(c.id) && r.getSchedule(c.schedule);
+    case Ipc::CmdQueryAll:
+        return true;
+    case Ipc::CmdSubscribe:
+        return r.get(c.mask);
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+TimerServer::TimerServer(TimerManager *manager, QObject *parent)
+    : QObject(parent), manager(manager), subscriberCount(0)
+{
+    connect(&server, &QLocalServer::newConnection, this, &TimerServer::onNewConnection);
+
+    connect(manager, &TimerManager::timerAdded, this, &TimerServer::onTimerAdded);
+    connect(manager, &TimerManager::timersAdded, this, [this](const QVector<int> &ids) {
+        for (int id : ids) onTimerAdded(id);
+    });
+    connect(manager, &TimerManager::timersUpdated, this, &TimerServer::onTimersUpdated);
+    connect(manager, &TimerManager::timerFinished, this, &TimerServer::onTimerFinished);
+    connect(manager, &TimerManager::timersRemoved, this, &TimerServer::onTimersRemoved);
+
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(0);
+    connect(&flushTimer, &QTimer::timeout, this, &TimerServer::flushEvents);
+}
+
+bool TimerServer::listen(const QString &name)
+{
+    QLocalServer::removeServer(name);
+    server.setSocketOptions(QLocalServer::UserAccessOption);
+    return server.listen(name);
+}
+
+void TimerServer::onNewConnection()
+{
+    while (QLocalSocket *socket = server.nextPendingConnection()) {
+        clients.insert(socket, Client());
+        connect(socket, &QLocalSocket::readyRead, this, &TimerServer::onReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &TimerServer::onDisconnected);
+    }
+}
+
+void TimerServer::onDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    auto it = clients.find(socket);
+    if (it == clients.end()) return;
+    if (it->mask) --subscriberCount;
+    clients.erase(it);
+    socket->deleteLater();
+}
+
+void TimerServer::onReadyRead()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    auto it = clients.find(socket);
+    if (it == clients.end()) return;
+
+    it->buffer.append(socket->readAll());
+
+    quint8 type;
+    QByteArray body;
+    bool error = false;
+    while (Ipc::takeFrame(it->buffer, type, body, &error)) {
+        QByteArray reply;
+        if (type != Ipc::FrameRequest || !execute(*it, body, reply)) {
+            error = true;
+            break;
+        }
+        socket->write(Ipc::frame(Ipc::FrameReply, reply));
+    }
+
+    // Порушення протоколу — клієнта відключаємо, стан менеджера при цьому не страждає
+    if (error) socket->disconnectFromServer();
+}
+
+bool TimerServer::execute(Client &client, const QByteArray &body, QByteArray &reply)
+{
+    Reader r(body);
+    quint32 seq, count;
+    if (!r.get(seq) || !r.get(count)) return false;
+
+    QVector<Command> commands;
+    commands.reserve(int(qMin<quint32>(count, 1 << 20)));
+    for (quint32 i = 0; i < count; ++i) {
+        Command c;
+        if (!parseCommand(r, c)) return false;
+        commands.append(c);
+    }
+
+    put(reply, seq);
+    put(reply, count);
+
+    for (int i = 0; i < commands.size();) {
+        const Command &c = commands[i];
+
+        // Серія однакових пакетних команд — одна пакетна операція менеджера.
+        // Статус — чи існував таймер на момент запиту
+        if (isBulk(c.op)) {
+            QList<int> ids;
+            int j = i;
+            for (; j < commands.size() && commands[j].op == c.op; ++j) {
+                ids.append(commands[j].id);
+                put(reply, c.op);
+                put(reply, qint32(manager->getTimerById(commands[j].id) ? 1 : 0));
+            }
+            switch (c.op) {
+            case Ipc::CmdStart: manager->startTimers(ids); break;
+            case Ipc::CmdPause: manager->pauseTimers(ids); break;
+            case Ipc::CmdRemove: manager->removeTimers(ids); break;
+            case Ipc::CmdReset: manager->resetTimers(ids); break;
+            }
+            i = j;
+            continue;
+        }
+
+        // Серія додавань — одне addTimers з його перевірками: назва непорожня й унікальна,
+        // розклад коректний, тривалість таймера не за розкладом додатна. Відхилені отримують -1
+        if (c.op == Ipc::CmdAdd) {
+            QVector<TimerManager::NewTimer> list;
+            int j = i;
+            for (; j < commands.size() && commands[j].op == Ipc::CmdAdd; ++j)
+                list.append({commands[j].name, TimerDuration(commands[j].durationMs), commands[j].schedule});
+            QVector<int> rejected;
+            QVector<int> ids = manager->addTimers(list, &rejected);
+            for (int k = 0, added = 0, skipped = 0; k < list.size(); ++k) {
+                put(reply, c.op);
+                bool ok = skipped >= rejected.size() || rejected[skipped] != k;
+                put(reply, qint32(ok ? ids[added++] : -1));
+                if (!ok) ++skipped;
+            }
+            i = j;
+            continue;
+        }
+
+        put(reply, c.op);
+        switch (c.op) {
+        case Ipc::CmdUpdate: {
+            // Тривалість перевіряє сам updateTimer — за тим самим правилом, що й для редагування в GUI
+            bool ok = !c.name.isEmpty() && manager->isNameUnique(c.name, c.id)
+                      && manager->updateTimer(c.id, c.name, TimerDuration(c.durationMs));
+            put(reply, qint32(ok ? 1 : 0));
+            break;
+        }
+        case Ipc::CmdSetSchedule:
+            put(reply, qint32(manager->setSchedule(c.id, c.schedule) ? 1 : 0));
+            break;
+        case Ipc::CmdQuery: {
+            // Той самий опублікований знімок, що й для CmdQueryAll: між запитами копіюються лише змінені записи
+            TimerSnapshot current = manager->snapshot();
+            const TimerRecord *r = current.find(c.id);
+            put(reply, qint32(r ? 1 : 0));
+            if (r) Ipc::putTimer(reply, Ipc::recordOf(current, *r, current.nowMs(), current.wallNowMs()));
+            break;
+        }
+        case Ipc::CmdQueryAll: {
+            // Знімок узгоджений на один момент, хоч би скільки тривала серіалізація
+            TimerSnapshot all = manager->snapshot();
+            qint64 now = all.nowMs();
+            qint64 wallNow = all.wallNowMs();
+            put(reply, qint32(all.count()));
+            all.forEach([&](const TimerRecord &r) { Ipc::putTimer(reply, Ipc::recordOf(all, r, now, wallNow)); });
+            break;
+        }
+        case Ipc::CmdSubscribe:
+            if (bool(client.mask) != bool(c.mask)) subscriberCount += c.mask ? 1 : -1;
+            client.mask = c.mask;
+            put(reply, qint32(1));
+            break;
+        }
+        ++i;
+    }
+    return true;
+}
+
+void TimerServer::queueEvent(quint8 mask, Ipc::EventType type, int id)
+{
+    if (subscriberCount == 0) return;
+
+    // Запис кодується один раз і копіюється всім підписаним клієнтам
+    QByteArray event;
+    put(event, quint8(type));
+    if (type == Ipc::EventRemoved) {
+        put(event, qint32(id));
+    } else {
+        TimerView t = manager->getTimerById(id);
+        if (!t) return;
+        Ipc::putTimer(event, Ipc::recordOf(t, manager->clock()->wallMs()));
+    }
+
+    for (Client &client : clients) {
+        if (!(client.mask & mask)) continue;
+        client.events.append(event);
+        ++client.eventCount;
+    }
+    if (!flushTimer.isActive()) flushTimer.start();
+}
+
+void TimerServer::onTimerAdded(int id)
+{
+    queueEvent(Ipc::SubscribeChanges, Ipc::EventAdded, id);
+}
+
+void TimerServer::onTimersUpdated(const QVector<int> &ids)
+{
+    for (int id : ids) queueEvent(Ipc::SubscribeChanges, Ipc::EventUpdated, id);
+}
+
+void TimerServer::onTimerFinished(int id)
+{
+    queueEvent(Ipc::SubscribeFinished, Ipc::EventFinished, id);
+}
+
+void TimerServer::onTimersRemoved(const QVector<int> &ids)
+{
+    for (int id : ids) queueEvent(Ipc::SubscribeChanges, Ipc::EventRemoved, id);
+}
+
+void TimerServer::flushEvents()
+{
+    for (auto it = clients.begin(); it != clients.end(); ++it) {
+        if (it->eventCount == 0) continue;
+
+        QByteArray body;
+        body.reserve(4 + it->events.size());
+        put(body, it->eventCount);
+        body.append(it->events);
+        it.key()->write(Ipc::frame(Ipc::FrameEvents, body));
+
+        it->events.clear();
+        it->eventCount = 0;
+    }
+}
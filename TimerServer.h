@@ -0,0 +1,60 @@
+#ifndef TIMERSERVER_H
+#define TIMERSERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QLocalServer>
+#include <QTimer>
+#include "IpcProtocol.h"
+
+class QLocalSocket;
+class TimerManager;
+
+// Сервер керування таймерами через локальний сокет (протокол — IpcProtocol.h).
+// Кожен клієнт може підписатися на потік подій; події однієї ітерації циклу подій
+// йдуть одним кадром на клієнта.
+class TimerServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimerServer(TimerManager *manager, QObject *parent = nullptr);
+
+    static QString defaultName() { return "smarttimer"; }
+
+    // Залишений після аварійного завершення сокет з тією ж назвою прибирається
+    bool listen(const QString &name = defaultName());
+    QString serverName() const { return server.fullServerName(); }
+    QString errorString() const { return server.errorString(); }
+    int clientCount() const { return clients.size(); }
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+
+    void onTimerAdded(int id);
+    void onTimersUpdated(const QVector<int> &ids);
+    void onTimerFinished(int id);
+    void onTimersRemoved(const QVector<int> &ids);
+    void flushEvents();
+
+private:
+    struct Client {
+        QByteArray buffer;
+        quint8 mask = 0;
+        QByteArray events;
+        quint32 eventCount = 0;
+    };
+
+    TimerManager *manager;
+    QLocalServer server;
+    QHash<QLocalSocket*, Client> clients;
+    QTimer flushTimer;
+    int subscriberCount;
+
+    bool execute(Client &client, const QByteArray &body, QByteArray &reply);
+    void queueEvent(quint8 mask, Ipc::EventType type, int id);
+};
+
+#endif // TIMERSERVER_H
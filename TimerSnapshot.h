@@ -0,0 +1,75 @@
+#ifndef TIMERSNAPSHOT_H
+#define TIMERSNAPSHOT_H
+
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "TimerDuration.h"
+#include "TimerSchedule.h"
+#include "TimerAction.h"
+#include "GroupClocks.h"
+#include "PersistentVector.h"
+#include "Clock.h"
+
+// Стан одного таймера в знімку
+struct TimerRecord {
+    int id = 0;                 // 0 — таймера з таким id у знімку немає
+    QString name;
+    TimerDuration duration{0};
+    qint64 remainingMs = 0;     // залишок таймера на паузі
+    qint64 deadline = 0;        // дедлайн запущеного таймера, у часі його групи
+    bool running = false;
+    int group = 0;
+    TimerSchedule schedule;
+    QVector<TimerAction> actions;
+};
+
+// Незмінний знімок усіх таймерів на момент публікації. Копіюється за O(1), вузли спільні з менеджером
+// і наступними знімками; подальші зміни таймерів на ньому не позначаються. Можна тримати скільки завгодно
+// і читати з будь-якого потоку
+class TimerSnapshot
+{
+public:
+    TimerSnapshot() = default;
+
+    bool isNull() const { return timeSource == nullptr; }
+
+    // Номер публікації; зростає з кожною публікацією, в якій щось змінилось
+    quint64 version() const { return publication; }
+    int count() const { return live; }
+
+    const TimerRecord *find(int id) const
+    {
+        if (id <= 0 || id >= records.size()) return nullptr;
+        const TimerRecord &r = records.at(id);
+        return r.id == id ? &r : nullptr;
+    }
+
+    // Таймери за зростанням id
+    template <typename F>
+    void forEach(F f) const
+    {
+        records.forEach([&f](int, const TimerRecord &r) { if (r.id != 0) f(r); });
+    }
+
+    // Годинники груп на момент знімка; залишок і стан рахуються за ними
+    const GroupClocks &groups() const { return clocks; }
+    qint64 nowMs() const { return timeSource->monotonicMs(); }
+    qint64 wallNowMs() const { return timeSource->wallMs(); }
+    bool isTicking(const TimerRecord &r) const { return r.running && clocks.isRunning(r.group); }
+    qint64 remainingMs(const TimerRecord &r, qint64 now) const
+    {
+        return r.running ? qMax<qint64>(0, r.deadline - clocks.time(r.group, now)) : r.remainingMs;
+    }
+
+private:
+    friend class TimerManager;
+
+    PersistentVector<TimerRecord> records;  // за id
+    GroupClocks clocks;
+    Clock *timeSource = nullptr;
+    quint64 publication = 0;
+    int live = 0;
+};
+
+#endif // TIMERSNAPSHOT_H
@@ -0,0 +1,187 @@
+#include "TimerStats.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtAlgorithms>
+
+std::atomic<quint64> TimerStats::allocations{0};
+
+int LatencyHistogram::bucketOf(quint64 v)
+{
+    if (v < quint64(2 * SubBuckets)) return int(v);
+
+    int msb = 63 - qCountLeadingZeroBits(v);
+    if (msb >= MaxBits) return BucketCount - 1;
+
+    int shift = msb - SubBucketBits;
+    int top = int(v >> shift);   // у межах [SubBuckets, 2 * SubBuckets)
+    return 2 * SubBuckets + (shift - 1) * SubBuckets + (top - SubBuckets);
+}
+
+quint64 LatencyHistogram::bucketUpper(int index)
+{
+    if (index < 2 * SubBuckets) return quint64(index);
+
+    int shift = (index - 2 * SubBuckets) / SubBuckets + 1;
+    quint64 top = quint64((index - 2 * SubBuckets) % SubBuckets + SubBuckets);
+    return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 us)
+{
+    if (us < 0) us = 0;
+    if (buckets.isEmpty()) buckets.resize(BucketCount);
+
+    ++buckets[bucketOf(quint64(us))];
+    if (total == 0 || us < minValue) minValue = us;
+    if (us > maxValue) maxValue = us;
+    sum += us;
+    ++total;
+}
+
+void LatencyHistogram::reset()
+{
+    buckets.clear();
+    total = 0;
+    sum = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+qint64 LatencyHistogram::percentile(double p) const
+{
+    if (total == 0) return 0;
+
+    quint64 rank = quint64(qBound(0.0, p, 100.0) / 100.0 * double(total) + 0.5);
+    if (rank == 0) rank = 1;
+
+    quint64 seen = 0;
+    for (int i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return qMin<qint64>(qint64(bucketUpper(i)), maxValue);
+    }
+    return maxValue;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+    QJsonObject o;
+    o["count"] = qint64(total);
+    o["min"] = min();
+    o["mean"] = mean();
+    o["p50"] = percentile(50);
+    o["p90"] = percentile(90);
+    o["p99"] = percentile(99);
+    o["p999"] = percentile(99.9);
+    o["max"] = max();
+    return o;
+}
+
+void TimerStats::PerSecond::roll(qint64 now)
+{
+    if (now == second) return;
+    previous = now == second + 1 ? current : 0;
+    current = 0;
+    second = now;
+}
+
+TimerStats::TimerStats()
+    : updateEmittedUs(-1), allocationMark(allocationTotal())
+{
+    clock.start();
+}
+
+void TimerStats::countExpirations(int n)
+{
+    expirations.add(currentSecond(), quint64(n));
+}
+
+void TimerStats::countRepaint()
+{
+    repaints.add(currentSecond(), 1);
+}
+
+void TimerStats::markUpdatesEmitted()
+{
+    // Кілька сигналів до одного paint міряються від першого — саме його користувач чекає найдовше
+    if (updateEmittedUs < 0) updateEmittedUs = elapsedUs();
+}
+
+void TimerStats::markPainted()
+{
+    countRepaint();
+    if (updateEmittedUs < 0) return;
+
+    signalToPaint.record(elapsedUs() - updateEmittedUs);
+    updateEmittedUs = -1;
+}
+
+int TimerStats::expirationsPerSecond()
+{
+    return int(expirations.rate(currentSecond()));
+}
+
+int TimerStats::repaintsPerSecond()
+{
+    return int(repaints.rate(currentSecond()));
+}
+
+void TimerStats::sampleAllocations()
+{
+    quint64 now = allocationTotal();
+    allocationRate.add(currentSecond(), now - allocationMark);
+    allocationMark = now;
+}
+
+int TimerStats::allocationsPerSecond()
+{
+    sampleAllocations();
+    return int(allocationRate.rate(currentSecond()));
+}
+
+void TimerStats::reset()
+{
+    expiryLateness.reset();
+    tickProcessing.reset();
+    signalToPaint.reset();
+    expirations = PerSecond();
+    repaints = PerSecond();
+    allocationRate = PerSecond();
+    allocationMark = allocationTotal();
+    updateEmittedUs = -1;
+    clock.restart();
+}
+
+QJsonObject TimerStats::toJson()
+{
+    QJsonObject histograms;
+    histograms["expiryLatenessUs"] = expiryLateness.toJson();
+    histograms["tickProcessingUs"] = tickProcessing.toJson();
+    histograms["signalToPaintUs"] = signalToPaint.toJson();
+
+    QJsonObject perSecond;
+    perSecond["expirations"] = expirationsPerSecond();
+    perSecond["repaints"] = repaintsPerSecond();
+    perSecond["allocations"] = allocationsPerSecond();
+
+    QJsonObject totals;
+    totals["expirations"] = qint64(expirations.total);
+    totals["repaints"] = qint64(repaints.total);
+    totals["allocations"] = qint64(allocationRate.total);
+
+    QJsonObject o;
+    o["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+    o["uptimeMs"] = clock.elapsed();
+    o["histograms"] = histograms;
+    o["perSecond"] = perSecond;
+    o["totals"] = totals;
+    return o;
+}
+
+bool TimerStats::dumpToFile(const QString &path)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
@@ -0,0 +1,103 @@
+#ifndef TIMERSTATS_H
+#define TIMERSTATS_H
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+// Гістограма затримок у стилі HDR: лінійні кошики до 64 мкс, далі по 32 кошики на кожен степінь двійки.
+// Відносна похибка перцентилів — не гірше ~3%, пам'ять не залежить від кількості записів.
+class LatencyHistogram
+{
+public:
+    void record(qint64 us);
+    void reset();
+
+    quint64 count() const { return total; }
+    qint64 min() const { return total ? minValue : 0; }
+    qint64 max() const { return maxValue; }
+    double mean() const { return total ? double(sum) / double(total) : 0.0; }
+    qint64 percentile(double p) const;   // p у діапазоні 0..100
+
+    QJsonObject toJson() const;
+
+private:
+    static constexpr int SubBucketBits = 5;
+    static constexpr int SubBuckets = 1 << SubBucketBits;
+    static constexpr int MaxBits = 40;   // значення понад ~12 діб обрізаються
+    static constexpr int BucketCount = 2 * SubBuckets + (MaxBits - SubBucketBits - 1) * SubBuckets;
+
+    static int bucketOf(quint64 v);
+    static quint64 bucketUpper(int index);
+
+    QVector<quint64> buckets;   // виділяється при першому записі
+    quint64 total = 0;
+    qint64 sum = 0;
+    qint64 minValue = 0;
+    qint64 maxValue = 0;
+};
+
+// Вбудована інструментація таймерів: запізнення спрацювань, час обробки тіку,
+// затримка від сигналу до перемальовування, а також лічильники подій за секунду.
+// Записується лише з потоку менеджера; лічильник виділень пам'яті — атомарний і глобальний.
+class TimerStats
+{
+public:
+    TimerStats();
+
+    LatencyHistogram expiryLateness;    // мкс від дедлайну до обробки спрацювання
+    LatencyHistogram tickProcessing;    // мкс на один прохід драйвера
+    LatencyHistogram signalToPaint;     // мкс від timersUpdated до перемальовування таблиці
+
+    qint64 elapsedUs() const { return clock.nsecsElapsed() / 1000; }
+
+    void countExpirations(int n);
+    void countRepaint();
+
+    // Пара для signalToPaint: перший paint після сигналу закриває вимір
+    void markUpdatesEmitted();
+    void markPainted();
+
+    int expirationsPerSecond();
+    int repaintsPerSecond();
+    int allocationsPerSecond();
+
+    // Лічильник виділень наповнює застосунок (див. AllocationCounter.cpp); без нього лишається нулем
+    static void noteAllocation() { allocations.fetch_add(1, std::memory_order_relaxed); }
+    static quint64 allocationTotal() { return allocations.load(std::memory_order_relaxed); }
+
+    void reset();
+
+    QJsonObject toJson();
+    bool dumpToFile(const QString &path);
+
+private:
+    // Лічильник з лінивим перекочуванням: рахує поточну секунду і пам'ятає попередню
+    struct PerSecond {
+        qint64 second = 0;
+        quint64 current = 0;
+        quint64 previous = 0;
+        quint64 total = 0;
+
+        void roll(qint64 now);
+        void add(qint64 now, quint64 n) { roll(now); current += n; total += n; }
+        quint64 rate(qint64 now) { roll(now); return previous; }
+    };
+
+    QElapsedTimer clock;
+    qint64 updateEmittedUs;
+    PerSecond expirations;
+    PerSecond repaints;
+    PerSecond allocationRate;
+    quint64 allocationMark;
+
+    qint64 currentSecond() const { return clock.elapsed() / 1000; }
+    void sampleAllocations();
+
+    static std::atomic<quint64> allocations;
+};
+
+#endif // TIMERSTATS_H
@@ -0,0 +1,262 @@
+#include "TimerStorage.h"
+#include <QtAlgorithms>
+#include <cstring>
+
+void TimerStorage::setCompact(bool value)
+{
+    Q_ASSERT(capacity() == 0);
+    compact = value;
+}
+
+SlotHandle TimerStorage::insert(int id, const QString &name, TimerDuration duration)
+{
+    int slot;
+    if (!freeSlots.isEmpty()) {
+        slot = freeSlots.last();
+        freeSlots.removeLast();
+    } else {
+        slot = generations.size();
+        ids.append(0);
+        generations.append(0);
+        deadlines.append(0);
+        remainings.append(0);
+        wheelNodes.append(-1);
+        armSeqs.append(0);
+        durations.append(0);
+        if (compact) nameOffsets.append(0);
+        else names.append(QString());
+        if ((slot & 63) == 0) runningBits.append(0);
+    }
+
+    ids[slot] = id;
+    deadlines[slot] = 0;
+    remainings[slot] = duration.count();
+    wheelNodes[slot] = -1;
+    armSeqs[slot] = 0;
+    durations[slot] = duration.count();
+    if (compact) nameOffsets[slot] = appendToArena(name);
+    else names[slot] = name;
+    setRunning(slot, false);
+    touch(slot);
+
+    ++generations[slot];
+    ++live;
+    return SlotHandle{slot, generations[slot]};
+}
+
+bool TimerStorage::remove(SlotHandle h)
+{
+    if (!contains(h)) return false;
+
+    setRunning(h.index, false);
+    if (tracking) removedIds.append(ids[h.index]);
+    if (compact) arenaGarbage += arenaRecordSize(h.index);
+    else names[h.index] = QString();
+    schedules.remove(h.index);
+    groups.remove(h.index);
+    actionLists.remove(h.index);
+    ++generations[h.index];
+    freeSlots.append(h.index);
+    --live;
+    if (arenaGarbage > 65536 && arenaGarbage * 2 > nameArena.size()) compactArena();
+    return true;
+}
+
+void TimerStorage::reserve(int n)
+{
+    ids.reserve(n);
+    generations.reserve(n);
+    deadlines.reserve(n);
+    remainings.reserve(n);
+    wheelNodes.reserve(n);
+    armSeqs.reserve(n);
+    durations.reserve(n);
+    if (compact) nameOffsets.reserve(n);
+    else names.reserve(n);
+    runningBits.reserve((n + 63) / 64);
+}
+
+void TimerStorage::setName(int slot, const QString &name)
+{
+    touch(slot);
+    if (!compact) {
+        names[slot] = name;
+        return;
+    }
+    arenaGarbage += arenaRecordSize(slot);
+    nameOffsets[slot] = appendToArena(name);
+    if (arenaGarbage > 65536 && arenaGarbage * 2 > nameArena.size()) compactArena();
+}
+
+void TimerStorage::setSchedule(int slot, const TimerSchedule &s)
+{
+    touch(slot);
+    if (s.kind == TimerSchedule::Once) schedules.remove(slot);
+    else schedules.insert(slot, s);
+}
+
+void TimerStorage::setGroup(int slot, int group)
+{
+    touch(slot);
+    if (group == 0) groups.remove(slot);
+    else groups.insert(slot, group);
+}
+
+void TimerStorage::setActions(int slot, const QVector<TimerAction> &actions)
+{
+    touch(slot);
+    if (actions.isEmpty()) actionLists.remove(slot);
+    else actionLists.insert(slot, actions);
+}
+
+quint32 TimerStorage::appendToArena(const QString &name)
+{
+    QByteArray utf8 = name.toUtf8();
+    if (utf8.size() > 0xFFFF) {
+        // Обрізання не посеред символу: відступаємо з байтів продовження 10xxxxxx
+        int cut = 0xFFFF;
+        while (cut > 0 && (quint8(utf8[cut]) & 0xC0) == 0x80) --cut;
+        utf8.truncate(cut);
+    }
+    quint32 offset = quint32(nameArena.size());
+    quint16 len = quint16(utf8.size());
+    nameArena.append(reinterpret_cast<const char*>(&len), sizeof(len));
+    nameArena.append(utf8);
+    return offset;
+}
+
+int TimerStorage::arenaRecordSize(int slot) const
+{
+    quint16 len;
+    memcpy(&len, nameArena.constData() + nameOffsets[slot], sizeof(len));
+    return int(sizeof(len)) + len;
+}
+
+QString TimerStorage::nameFromArena(int slot) const
+{
+    const char *record = nameArena.constData() + nameOffsets[slot];
+    quint16 len;
+    memcpy(&len, record, sizeof(len));
+    return QString::fromUtf8(record + sizeof(len), len);
+}
+
+bool TimerStorage::nameIsUtf8(int slot, const QByteArray &utf8) const
+{
+    const char *record = nameArena.constData() + nameOffsets[slot];
+    quint16 len;
+    memcpy(&len, record, sizeof(len));
+    return len == utf8.size() && memcmp(record + sizeof(len), utf8.constData(), len) == 0;
+}
+
+// Живі записи переносяться в нову арену; час — O(розміру арени), викликається рідко
+void TimerStorage::compactArena()
+{
+    QByteArray fresh;
+    fresh.reserve(nameArena.size() - int(arenaGarbage));
+    for (int slot = 0; slot < generations.size(); ++slot) {
+        if (!isLive(slot)) continue;
+        int size = arenaRecordSize(slot);
+        quint32 offset = quint32(fresh.size());
+        fresh.append(nameArena.constData() + nameOffsets[slot], size);
+        nameOffsets[slot] = offset;
+    }
+    nameArena = fresh;
+    arenaGarbage = 0;
+}
+
+void TimerStorage::setRunning(int slot, bool running)
+{
+    quint64 bit = quint64(1) << (slot & 63);
+    if (running) runningBits[slot >> 6] |= bit;
+    else runningBits[slot >> 6] &= ~bit;
+    touch(slot);
+}
+
+void TimerStorage::setTracking(bool on)
+{
+    tracking = on;
+    changedBits.clear();
+    changedSlots.clear();
+    removedIds.clear();
+}
+
+void TimerStorage::markChanged(int slot)
+{
+    int word = slot >> 6;
+    if (word >= changedBits.size()) changedBits.resize(word + 1);
+    quint64 bit = quint64(1) << (slot & 63);
+    if (changedBits[word] & bit) return;
+    changedBits[word] |= bit;
+    changedSlots.append(slot);
+}
+
+void TimerStorage::takeChanges(QVector<int> &slots, QVector<int> &removed)
+{
+    for (int slot : changedSlots) changedBits[slot >> 6] &= ~(quint64(1) << (slot & 63));
+    slots.swap(changedSlots);
+    removed.swap(removedIds);
+    changedSlots.clear();
+    removedIds.clear();
+}
+
+int TimerStorage::countRunning() const
+{
+    int n = 0;
+    const quint64 *bits = runningBits.constData();
+    for (int i = 0, words = runningBits.size(); i < words; ++i) n += qPopulationCount(bits[i]);
+    return n;
+}
+
+qint64 TimerStorage::nextDeadline() const
+{
+    qint64 best = -1;
+    const quint64 *bits = runningBits.constData();
+    const qint64 *dl = deadlines.constData();
+    for (int w = 0, words = runningBits.size(); w < words; ++w) {
+        quint64 word = bits[w];
+        while (word) {
+            int slot = w * 64 + qCountTrailingZeroBits(word);
+            if ((best < 0 || dl[slot] < best) && group(slot) == 0) best = dl[slot];
+            word &= word - 1;
+        }
+    }
+    return best;
+}
+
+namespace {
+
+// Qt 6 тримає рядок у купі з заголовком QArrayData
+qint64 stringBytes(const QString &s)
+{
+    return s.isNull() ? 0 : qint64(sizeof(QArrayData)) + (s.capacity() + 1) * qint64(sizeof(QChar));
+}
+
+} // namespace
+
+qint64 TimerStorage::memoryBytes() const
+{
+    qint64 bytes = sizeof(*this);
+    bytes += ids.capacity() * qint64(sizeof(int));
+    bytes += generations.capacity() * qint64(sizeof(quint32));
+    bytes += deadlines.capacity() * qint64(sizeof(qint64));
+    bytes += remainings.capacity() * qint64(sizeof(qint64));
+    bytes += wheelNodes.capacity() * qint64(sizeof(int));
+    bytes += armSeqs.capacity() * qint64(sizeof(quint32));
+    bytes += runningBits.capacity() * qint64(sizeof(quint64));
+    bytes += durations.capacity() * qint64(sizeof(qint64));
+    bytes += freeSlots.capacity() * qint64(sizeof(int));
+
+    bytes += names.capacity() * qint64(sizeof(QString));
+    for (const QString &name : names) bytes += stringBytes(name);
+    bytes += nameOffsets.capacity() * qint64(sizeof(quint32)) + nameArena.capacity();
+
+    // Вузол QHash — ключ і значення; плюс байт зсуву в прольоті на кожне місце
+    bytes += schedules.capacity() * qint64(sizeof(int) + sizeof(TimerSchedule) + 1);
+    bytes += groups.capacity() * qint64(2 * sizeof(int) + 1);
+    bytes += actionLists.capacity() * qint64(sizeof(int) + sizeof(QVector<TimerAction>) + 1);
+    for (const QVector<TimerAction> &list : actionLists) {
+        bytes += list.capacity() * qint64(sizeof(TimerAction));
+        for (const TimerAction &action : list) bytes += stringBytes(action.argument);
+    }
+    return bytes;
+}
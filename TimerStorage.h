@@ -0,0 +1,198 @@
+#ifndef TIMERSTORAGE_H
+#define TIMERSTORAGE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include "TimerDuration.h"
+#include "TimerSchedule.h"
+#include "TimerAction.h"
+#include "GroupClocks.h"
+#include "Clock.h"
+
+// Дескриптор запису в TimerStorage. Покоління відсікає застарілі дескриптори:
+// після видалення слот перевикористовується вже з іншим поколінням.
+struct SlotHandle {
+    int index = -1;
+    quint32 generation = 0;
+
+    bool isNull() const { return index < 0; }
+    bool operator==(const SlotHandle &o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const SlotHandle &o) const { return !(*this == o); }
+};
+
+// Сховище таймерів у вигляді структури масивів.
+// Гарячі поля (дедлайни, залишки, біти "запущено") лежать у суцільних масивах,
+// тож проходи на кшталт "скільки запущено" чи "найближчий дедлайн" не тягнуть у кеш назви.
+// Назви — окрема холодна таблиця. Слоти стабільні і перевикористовуються через список вільних.
+// Рідкісні поля (розклад повторення, група) зберігаються розріджено — лише для таймерів, де вони є.
+class TimerStorage
+{
+public:
+    // Компактний режим: назви в UTF-8 підряд у спільній арені замість окремого QString на таймер.
+    // Перемикається лише поки сховище порожнє
+    void setCompact(bool compact);
+    bool isCompact() const { return compact; }
+
+    // Монотонний час у мілісекундах, у тій самій шкалі, що й дедлайни
+    qint64 nowMs() const { return timeSource->monotonicMs(); }
+    Clock *clock() const { return timeSource; }
+    void setClock(Clock *clock) { timeSource = clock; }
+
+    SlotHandle insert(int id, const QString &name, TimerDuration duration);
+    bool remove(SlotHandle h);
+    void reserve(int n);
+
+    bool contains(SlotHandle h) const
+    {
+        return h.index >= 0 && h.index < generations.size() && generations[h.index] == h.generation
+               && (h.generation & 1);
+    }
+    bool isLive(int slot) const { return generations[slot] & 1; }
+
+    int size() const { return live; }
+    int capacity() const { return generations.size(); }
+
+    // Гарячі поля
+    int id(int slot) const { return ids[slot]; }
+    SlotHandle handle(int slot) const { return SlotHandle{slot, generations[slot]}; }
+    bool isRunning(int slot) const { return (runningBits[slot >> 6] >> (slot & 63)) & 1; }
+    void setRunning(int slot, bool running);
+    // Дедлайн — момент на годиннику таймера (монотонному чи групи), а не тривалість, тож він у сирих мс
+    qint64 deadline(int slot) const { return deadlines[slot]; }
+    void setDeadline(int slot, qint64 ms) { deadlines[slot] = ms; touch(slot); }
+    TimerDuration remaining(int slot) const { return TimerDuration(remainings[slot]); }
+    void setRemaining(int slot, TimerDuration d) { remainings[slot] = d.count(); touch(slot); }
+    int wheelNode(int slot) const { return wheelNodes[slot]; }
+    void setWheelNode(int slot, int node) { wheelNodes[slot] = node; }
+    quint32 armSeq(int slot) const { return armSeqs[slot]; }
+    void setArmSeq(int slot, quint32 seq) { armSeqs[slot] = seq; }
+
+    // Холодні поля
+    TimerDuration duration(int slot) const { return TimerDuration(durations[slot]); }
+    void setDuration(int slot, TimerDuration d) { durations[slot] = d.count(); touch(slot); }
+    QString name(int slot) const { return compact ? nameFromArena(slot) : names[slot]; }
+    void setName(int slot, const QString &name);
+    bool nameIsUtf8(int slot, const QByteArray &utf8) const;    // лише в компактному режимі
+
+    const TimerSchedule &schedule(int slot) const
+    {
+        auto it = schedules.constFind(slot);
+        return it == schedules.constEnd() ? onceSchedule : it.value();
+    }
+    void setSchedule(int slot, const TimerSchedule &s);
+    int group(int slot) const { return groups.isEmpty() ? 0 : groups.value(slot); }
+    void setGroup(int slot, int group);
+
+    // Дії при спрацюванні; порожній список не зберігається
+    const QVector<TimerAction> &actions(int slot) const
+    {
+        if (actionLists.isEmpty()) return noActions;
+        auto it = actionLists.constFind(slot);
+        return it == actionLists.constEnd() ? noActions : it.value();
+    }
+    void setActions(int slot, const QVector<TimerAction> &actions);
+
+    // Годинники груп; дедлайн таймера з групою заданий у часі його групи
+    GroupClocks &clocks() { return groupClocks; }
+    const GroupClocks &clocks() const { return groupClocks; }
+    qint64 clockNow(int slot, qint64 now) const { return groupClocks.time(group(slot), now); }
+
+    // Запущений таймер, годинник якого справді йде (група не на паузі)
+    bool isTicking(int slot) const { return isRunning(slot) && groupClocks.isRunning(group(slot)); }
+
+    // Залишок рахується лише при читанні
+    TimerDuration remainingNow(int slot, qint64 now) const
+    {
+        return TimerDuration(isRunning(slot) ? qMax<qint64>(0, deadlines[slot] - clockNow(slot, now)) : remainings[slot]);
+    }
+
+    // Проходи по суцільних масивах
+    int countRunning() const;
+    qint64 nextDeadline() const;    // без таймерів груп; -1, якщо нічого не запущено
+
+    // Оцінка зайнятої пам'яті з урахуванням резерву масивів і рядків у купі
+    qint64 memoryBytes() const;
+
+    // Облік змін для знімків: поки він увімкнений, сховище запам'ятовує слоти, поля яких змінились,
+    // і id видалених таймерів. takeChanges забирає накопичене
+    void setTracking(bool on);
+    bool isTracking() const { return tracking; }
+    void takeChanges(QVector<int> &slots, QVector<int> &removed);
+
+private:
+    QVector<int> ids;
+    QVector<quint32> generations;   // непарне покоління — слот зайнятий
+    QVector<qint64> deadlines;      // монотонний дедлайн запущеного таймера (мс)
+    QVector<qint64> remainings;     // залишок таймера на паузі (мс)
+    QVector<int> wheelNodes;
+    QVector<quint32> armSeqs;
+    QVector<quint64> runningBits;
+
+    QVector<qint64> durations;      // мс
+    QVector<QString> names;         // звичайний режим
+    QHash<int, TimerSchedule> schedules;    // лише повторювані таймери
+    QHash<int, int> groups;         // лише таймери в групах
+    QHash<int, QVector<TimerAction>> actionLists;   // лише таймери з діями
+
+    // Компактний режим: слот -> зсув запису [quint16 довжина][UTF-8] в арені.
+    // Старі записи після перейменування чи видалення лишаються сміттям до ущільнення арени
+    bool compact = false;
+    QByteArray nameArena;
+    QVector<quint32> nameOffsets;
+    qint64 arenaGarbage = 0;
+
+    static inline const TimerSchedule onceSchedule{};
+    static inline const QVector<TimerAction> noActions{};
+
+    QString nameFromArena(int slot) const;
+    quint32 appendToArena(const QString &name);
+    int arenaRecordSize(int slot) const;
+    void compactArena();
+
+    GroupClocks groupClocks;
+    Clock *timeSource = Clock::system();
+
+    QVector<int> freeSlots;
+    int live = 0;
+
+    bool tracking = false;
+    QVector<quint64> changedBits;
+    QVector<int> changedSlots;
+    QVector<int> removedIds;
+
+    void touch(int slot) { if (tracking) markChanged(slot); }
+    void markChanged(int slot);
+};
+
+// Легке подання одного таймера: читає поля прямо зі сховища, нічого не копіюючи.
+// Дійсне до наступного видалення таймерів з менеджера.
+class TimerView
+{
+public:
+    TimerView() = default;
+    TimerView(const TimerStorage *storage, int slot) : storage(storage), slotIndex(slot) {}
+
+    bool isValid() const { return storage != nullptr; }
+    explicit operator bool() const { return isValid(); }
+
+    int slot() const { return slotIndex; }
+    int id() const { return storage->id(slotIndex); }
+    QString name() const { return storage->name(slotIndex); }
+    TimerDuration duration() const { return storage->duration(slotIndex); }
+    bool running() const { return storage->isRunning(slotIndex); }
+    const TimerSchedule &schedule() const { return storage->schedule(slotIndex); }
+    int group() const { return storage->group(slotIndex); }
+    const QVector<TimerAction> &actions() const { return storage->actions(slotIndex); }
+    bool ticking() const { return storage->isTicking(slotIndex); }
+
+    TimerDuration remaining() const { return storage->remainingNow(slotIndex, storage->nowMs()); }
+
+private:
+    const TimerStorage *storage = nullptr;
+    int slotIndex = -1;
+};
+
+#endif // TIMERSTORAGE_H
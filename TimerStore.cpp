@@ -0,0 +1,446 @@
+#include "TimerStore.h"
+#include "TimerManager.h"
+#include "BinaryCodec.h"
+#include <QDateTime>
+#include <QDir>
+#include <QHash>
+#include <QMap>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <utility>
+
+using namespace BinaryCodec;
+
+namespace {
+
+// Сигнатура файлу — "STS"/"STJ" і цифра версії формату.
+// Версія 2: тривалості — qint64 мілісекунди (у версії 1 — qint32 секунди). Версія 3: розклад повторення.
+// Версія 4: групи таймерів з віртуальними годинниками. Версія 5: дії при спрацюванні.
+// Старіші версії читаються й одразу ущільнюються в поточну
+const quint32 SnapshotPrefix = 0x535453;    // "STS"
+const quint32 JournalPrefix = 0x4A5453;     // "STJ"
+const int FormatVersion = 5;
+
+quint32 magicFor(quint32 prefix, int version)
+{
+    return prefix | (quint32('0' + version) << 24);
+}
+
+int versionOf(quint32 magic, quint32 prefix)
+{
+    int version = int(magic >> 24) - '0';
+    return (magic & 0xFFFFFF) == prefix && version >= 1 && version <= FormatVersion ? version : 0;
+}
+
+const int SnapshotHeaderSize = 4 + 4 + 4 + 4 + 8;
+const int JournalHeaderSize = 4 + 4;
+
+// Тривалість: у версії 1 — qint32 секунди, з версії 2 — qint64 мілісекунди
+bool getDuration(Reader &r, TimerDuration &d, bool legacy)
+{
+    if (legacy) {
+        qint32 seconds;
+        if (!r.get(seconds)) return false;
+        d = std::chrono::seconds(seconds);
+        return true;
+    }
+    qint64 ms;
+    if (!r.get(ms)) return false;
+    d = TimerDuration(ms);
+    return true;
+}
+
+// Група: батько, назва, прапорці і час групи за настінним годинником разом з моментом запису
+void putGroupBody(QByteArray &out, const StoredGroup &g, qint64 now)
+{
+    put(out, qint32(g.parent));
+    putString(out, g.name);
+    put(out, quint8(g.paused));
+    put(out, quint8(g.running));
+    put(out, qint64(now + g.skewMs));
+    put(out, now);
+}
+
+// Годинник, що йшов, доганяє час, який минув після запису
+bool getGroupBody(Reader &r, StoredGroup &g, qint64 now)
+{
+    qint32 parent;
+    quint8 paused, running;
+    qint64 clock, savedAt;
+    if (!r.get(parent) || !r.getString(g.name) || !r.get(paused) || !r.get(running)
+        || !r.get(clock) || !r.get(savedAt))
+        return false;
+    g.parent = parent;
+    g.paused = paused;
+    g.running = running;
+    g.skewMs = clock + (running ? now - savedAt : 0) - now;
+    return true;
+}
+
+} // namespace
+
+TimerStore::TimerStore(const QString &directory, QObject *parent)
+    : QObject(parent), manager(nullptr), generation(0), journalCount(0)
+{
+    QDir().mkpath(directory);
+    snapshotPath = QDir(directory).filePath("timers.snap");
+    journalPath = QDir(directory).filePath("timers.journal");
+
+    // Записи однієї ітерації циклу подій пишуться у файл одним викликом
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(0);
+    connect(&flushTimer, &QTimer::timeout, this, &TimerStore::flush);
+
+    compactTimer.setInterval(30000);
+    connect(&compactTimer, &QTimer::timeout, this, &TimerStore::maybeCompact);
+}
+
+TimerStore::~TimerStore()
+{
+    flush();
+}
+
+// Настінний час того ж годинника, що й у менеджера (симульованого в тестах)
+qint64 TimerStore::wallNow() const
+{
+    return manager ? manager->clock()->wallMs() : QDateTime::currentMSecsSinceEpoch();
+}
+
+QString TimerStore::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+}
+
+bool TimerStore::load(TimerManager *target)
+{
+    manager = target;
+    compactTimer.start();
+
+    QHash<int, int> indexById;
+    QVector<StoredTimer> list;
+    QMap<int, StoredGroup> groups;
+    qint64 now = wallNow();
+    int nextId = 1;
+    int version = FormatVersion;
+    generation = 0;
+
+    QFile snap(snapshotPath);
+    if (snap.open(QIODevice::ReadOnly) && snap.size() >= SnapshotHeaderSize) {
+        uchar *data = snap.map(0, snap.size());
+        if (data) {
+            Reader r(data, snap.size());
+            quint32 magic, gen, count;
+            qint32 storedNextId;
+            qint64 savedAt;
+            if (r.get(magic) && versionOf(magic, SnapshotPrefix) && r.get(gen)
+                && r.get(count) && r.get(storedNextId) && r.get(savedAt)) {
+                version = versionOf(magic, SnapshotPrefix);
+                generation = gen;
+                nextId = storedNextId;
+                list.reserve(int(count));
+                indexById.reserve(int(count));
+                for (quint32 i = 0; i < count; ++i) {
+                    StoredTimer t;
+                    qint32 id;
+                    if (!r.get(id) || !getDuration(r, t.duration, version < 2) || !r.get(t.remainingMs)
+                        || !r.get(t.wallDeadlineMs) || !r.getString(t.name)
+                        || (version >= 3 && !r.getSchedule(t.schedule)))
+                        break;
+                    qint32 group = 0;
+                    if (version >= 4 && !r.get(group)) break;
+                    if (version >= 5 && !r.getActions(t.actions)) break;
+                    t.id = id;
+                    t.group = group;
+                    indexById.insert(t.id, list.size());
+                    list.append(t);
+                }
+
+                quint32 groupCount = 0;
+                if (version >= 4 && r.get(groupCount)) {
+                    for (quint32 i = 0; i < groupCount; ++i) {
+                        StoredGroup g;
+                        qint32 id;
+                        if (!r.get(id) || !getGroupBody(r, g, now)) break;
+                        g.id = id;
+                        groups.insert(g.id, g);
+                    }
+                }
+            }
+            snap.unmap(data);
+        }
+    }
+
+    // Журнал застосовується лише якщо належить тому ж поколінню, що й знімок
+    bool journalValid = false;
+    qint64 journalValidSize = 0;
+    QFile jf(journalPath);
+    if (jf.open(QIODevice::ReadOnly) && jf.size() >= JournalHeaderSize) {
+        uchar *data = jf.map(0, jf.size());
+        if (data) {
+            Reader r(data, jf.size());
+            quint32 magic, gen;
+            // Версія журналу має збігатися з версією знімка
+            if (r.get(magic) && magic == magicFor(JournalPrefix, version) && r.get(gen) && gen == generation) {
+                journalValid = true;
+                journalValidSize = r.pos() - data;
+                while (!r.atEnd()) {
+                    quint8 op;
+                    qint32 id;
+                    if (!r.get(op) || !r.get(id)) break;
+
+                    // Обрізаний останній запис (аварійне завершення) просто відкидається
+                    if (op == OpAdd || op == OpUpdate) {
+                        TimerDuration duration;
+                        QString name;
+                        if (!getDuration(r, duration, version < 2) || !r.getString(name)) break;
+                        auto it = indexById.constFind(id);
+                        StoredTimer *t;
+                        if (it == indexById.constEnd()) {
+                            indexById.insert(id, list.size());
+                            list.append(StoredTimer{id, QString(), TimerDuration::zero(), 0, 0, TimerSchedule()});
+                            t = &list.last();
+                        } else {
+                            t = &list[it.value()];
+                        }
+                        t->name = name;
+                        t->duration = duration;
+                        t->remainingMs = duration.count();
+                        t->wallDeadlineMs = 0;
+                        nextId = qMax(nextId, int(id) + 1);
+                    } else if (op == OpStart || op == OpPause) {
+                        qint64 value;
+                        if (!r.get(value)) break;
+                        journalValidSize = r.pos() - data;
+                        auto it = indexById.constFind(id);
+                        if (it == indexById.constEnd()) continue;
+                        StoredTimer &t = list[it.value()];
+                        if (op == OpStart) t.wallDeadlineMs = value;
+                        else { t.remainingMs = value; t.wallDeadlineMs = 0; }
+                    } else if (op == OpSchedule) {
+                        TimerSchedule schedule;
+                        if (!r.getSchedule(schedule)) break;
+                        auto it = indexById.constFind(id);
+                        if (it != indexById.constEnd()) list[it.value()].schedule = schedule;
+                    } else if (op == OpGroup) {
+                        StoredGroup g;
+                        if (!getGroupBody(r, g, now)) break;
+                        g.id = id;
+                        groups.insert(g.id, g);
+                    } else if (op == OpGroupRemove) {
+                        groups.remove(id);
+                    } else if (op == OpMember) {
+                        qint32 group;
+                        if (!r.get(group)) break;
+                        auto it = indexById.constFind(id);
+                        if (it != indexById.constEnd()) list[it.value()].group = group;
+                    } else if (op == OpActions) {
+                        QVector<TimerAction> actions;
+                        if (!r.getActions(actions)) break;
+                        auto it = indexById.constFind(id);
+                        if (it != indexById.constEnd()) list[it.value()].actions = actions;
+                    } else if (op == OpRemove) {
+                        journalValidSize = r.pos() - data;
+                        auto it = indexById.find(id);
+                        if (it == indexById.end()) continue;
+                        list[it.value()].id = -1;
+                        indexById.erase(it);
+                    } else {
+                        break;
+                    }
+                    ++journalCount;
+                    journalValidSize = r.pos() - data;
+                }
+            }
+            jf.unmap(data);
+        }
+    }
+    // Обрізаний хвіст прибираємо, інакше нові записи ляжуть після сміття
+    bool truncatedTail = journalValid && journalValidSize < jf.size();
+    jf.close();
+    if (truncatedTail) QFile::resize(journalPath, journalValidSize);
+
+    // Час, що минув поки програма не працювала, списується з запущених таймерів —
+    // для таймерів групи за її годинником, який на паузі не йшов
+    QVector<StoredTimer> live;
+    live.reserve(indexById.size());
+    for (StoredTimer &t : list) {
+        if (t.id < 0) continue;
+        if (!groups.contains(t.group)) t.group = 0;
+        if (t.wallDeadlineMs != 0) {
+            qint64 clockNow = now + (t.group ? groups.value(t.group).skewMs : 0);
+            t.remainingMs = qMax<qint64>(0, t.wallDeadlineMs - clockNow);
+            // Повторюваний таймер лишається запущеним: пропущені повтори не наздоганяються,
+            // а розклад за календарем менеджер перерахує сам
+            qint64 period = t.duration.count();
+            if (t.remainingMs == 0 && t.schedule.kind == TimerSchedule::Repeat && period > 0)
+                t.remainingMs = period - (clockNow - t.wallDeadlineMs) % period;
+            else if (t.remainingMs == 0 && t.schedule.kind != TimerSchedule::Calendar) {
+                t.expiredAtMs = t.wallDeadlineMs - (clockNow - now);
+                t.wallDeadlineMs = 0;
+            }
+        }
+        live.append(std::move(t));
+    }
+
+    // Групи йдуть за зростанням id — батько завжди створений раніше за дочірню групу
+    manager->restoreGroups(groups.values());
+    manager->restoreTimers(live, nextId);
+
+    if (!journalValid) journalCount = 0;
+
+    // Старий формат одразу переписуємо в новий, щоб не дописувати нові записи в журнал версії 1
+    if (version < FormatVersion) return compact();
+    return openJournal(!journalValid);
+}
+
+bool TimerStore::openJournal(bool truncate)
+{
+    journal.close();
+    journal.setFileName(journalPath);
+    if (!journal.open(truncate ? (QIODevice::WriteOnly | QIODevice::Truncate)
+                               : (QIODevice::WriteOnly | QIODevice::Append)))
+        return false;
+
+    if (truncate || journal.size() == 0) {
+        QByteArray header;
+        put(header, magicFor(JournalPrefix, FormatVersion));
+        put(header, generation);
+        journal.write(header);
+        journal.flush();
+    }
+    return true;
+}
+
+void TimerStore::beginRecord(Op op, int id)
+{
+    put(pending, quint8(op));
+    put(pending, qint32(id));
+    ++journalCount;
+    if (!flushTimer.isActive()) flushTimer.start();
+}
+
+void TimerStore::logAdd(int id, const QString &name, TimerDuration duration)
+{
+    beginRecord(OpAdd, id);
+    put(pending, qint64(duration.count()));
+    putString(pending, name);
+}
+
+void TimerStore::logUpdate(int id, const QString &name, TimerDuration duration)
+{
+    beginRecord(OpUpdate, id);
+    put(pending, qint64(duration.count()));
+    putString(pending, name);
+}
+
+void TimerStore::logStart(int id, qint64 remainingMs, qint64 clockSkewMs)
+{
+    beginRecord(OpStart, id);
+    put(pending, qint64(wallNow() + clockSkewMs + remainingMs));
+}
+
+void TimerStore::logPause(int id, qint64 remainingMs)
+{
+    beginRecord(OpPause, id);
+    put(pending, remainingMs);
+}
+
+void TimerStore::logRemove(int id)
+{
+    beginRecord(OpRemove, id);
+}
+
+void TimerStore::logSchedule(int id, const TimerSchedule &schedule)
+{
+    beginRecord(OpSchedule, id);
+    putSchedule(pending, schedule);
+}
+
+void TimerStore::logGroup(const StoredGroup &group)
+{
+    beginRecord(OpGroup, group.id);
+    putGroupBody(pending, group, wallNow());
+}
+
+void TimerStore::logGroupRemove(int group)
+{
+    beginRecord(OpGroupRemove, group);
+}
+
+void TimerStore::logMember(int id, int group)
+{
+    beginRecord(OpMember, id);
+    put(pending, qint32(group));
+}
+
+void TimerStore::logActions(int id, const QVector<TimerAction> &actions)
+{
+    beginRecord(OpActions, id);
+    putActions(pending, actions);
+}
+
+void TimerStore::flush()
+{
+    if (pending.isEmpty() || !journal.isOpen()) return;
+    journal.write(pending);
+    journal.flush();
+    pending.clear();
+}
+
+void TimerStore::maybeCompact()
+{
+    if (manager && journalCount > qMax(4096, manager->count()))
+        compact();
+}
+
+bool TimerStore::compact()
+{
+    if (!manager) return false;
+
+    flush();
+
+    // Ущільнення синхронне, тож подань досить; знімок тут тримав би другу копію всіх записів,
+    // що звело б нанівець компактний режим сховища
+    QVector<int> ids = manager->timerIds();
+    QVector<StoredGroup> groups = manager->groupStates();
+    qint64 now = wallNow();
+
+    QHash<int, qint64> skewByGroup;
+    for (const StoredGroup &g : groups) skewByGroup.insert(g.id, g.skewMs);
+
+    QByteArray out;
+    out.reserve(SnapshotHeaderSize + ids.size() * 44);
+    put(out, magicFor(SnapshotPrefix, FormatVersion));
+    put(out, generation + 1);
+    put(out, quint32(ids.size()));
+    put(out, qint32(manager->peekNextId()));
+    put(out, now);
+
+    for (int id : ids) {
+        TimerView t = manager->getTimerById(id);
+        qint64 remaining = t.remaining().count();
+        put(out, qint32(t.id()));
+        put(out, qint64(t.duration().count()));
+        put(out, remaining);
+        put(out, qint64(t.running() ? now + skewByGroup.value(t.group()) + remaining : 0));
+        putString(out, t.name());
+        putSchedule(out, t.schedule());
+        put(out, qint32(t.group()));
+        putActions(out, t.actions());
+    }
+
+    put(out, quint32(groups.size()));
+    for (const StoredGroup &g : groups) {
+        put(out, qint32(g.id));
+        putGroupBody(out, g, now);
+    }
+
+    // Знімок підміняється атомарно; журнал старого покоління після цього ігнорується
+    QSaveFile file(snapshotPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(out) != out.size() || !file.commit())
+        return false;
+
+    ++generation;
+    journalCount = 0;
+    return openJournal(true);
+}
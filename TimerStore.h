@@ -0,0 +1,108 @@
+#ifndef TIMERSTORE_H
+#define TIMERSTORE_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QFile>
+#include <QTimer>
+#include <QVector>
+#include "TimerDuration.h"
+#include "TimerSchedule.h"
+#include "TimerAction.h"
+
+class TimerManager;
+
+// Стан таймера у сховищі. Для запущеного таймера зберігається дедлайн за настінним годинником,
+// щоб після перезапуску врахувати час, що минув.
+struct StoredTimer {
+    int id;
+    QString name;
+    TimerDuration duration;
+    qint64 remainingMs;
+    qint64 wallDeadlineMs;  // 0 — таймер на паузі; для таймера з групою — за годинником групи
+    TimerSchedule schedule;
+    int group = 0;
+    QVector<TimerAction> actions;
+    qint64 expiredAtMs = 0; // дедлайн за настінним годинником, що минув, поки програма не працювала
+};
+
+// Стан групи таймерів. skewMs — на скільки час групи відстає від поточного (або випереджає його);
+// у файлі зберігається як час групи за настінним годинником разом з моментом запису
+struct StoredGroup {
+    int id;
+    int parent;
+    QString name;
+    bool paused;
+    bool running;           // годинник іде: ні група, ні її предки не на паузі
+    qint64 skewMs;
+};
+
+// Персистентне сховище таймерів: компактний бінарний знімок + журнал операцій, що лише дописується.
+// Кожна зміна стану додає в журнал один короткий запис; знімок перезаписується тільки під час ущільнення.
+class TimerStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TimerStore(const QString &directory, QObject *parent = nullptr);
+    ~TimerStore();
+
+    static QString defaultDirectory();
+
+    // Відновлює таймери в manager (до підключення моделей) і запам'ятовує його для ущільнення
+    bool load(TimerManager *manager);
+
+    void logAdd(int id, const QString &name, TimerDuration duration);
+    void logUpdate(int id, const QString &name, TimerDuration duration);
+    // clockSkewMs — зсув годинника групи таймера відносно поточного часу
+    void logStart(int id, qint64 remainingMs, qint64 clockSkewMs = 0);
+    void logPause(int id, qint64 remainingMs);
+    void logRemove(int id);
+    void logSchedule(int id, const TimerSchedule &schedule);
+    void logGroup(const StoredGroup &group);
+    void logGroupRemove(int group);
+    void logMember(int id, int group);
+    void logActions(int id, const QVector<TimerAction> &actions);
+
+    // Переписує знімок з поточного стану менеджера і обнуляє журнал
+    bool compact();
+
+    int journalRecords() const { return journalCount; }
+
+public slots:
+    void flush();
+
+private slots:
+    void maybeCompact();
+
+private:
+    enum Op : quint8 {
+        OpAdd = 1,
+        OpUpdate,
+        OpStart,
+        OpPause,
+        OpRemove,
+        OpSchedule,
+        OpGroup,
+        OpGroupRemove,
+        OpMember,
+        OpActions
+    };
+
+    QString snapshotPath;
+    QString journalPath;
+    TimerManager *manager;
+
+    QFile journal;
+    QByteArray pending;
+    QTimer flushTimer;
+    QTimer compactTimer;
+    quint32 generation;
+    int journalCount;
+
+    qint64 wallNow() const;
+    bool openJournal(bool truncate);
+    void beginRecord(Op op, int id);
+};
+
+#endif // TIMERSTORE_H
@@ -0,0 +1,441 @@
+#include "TimerTableModel.h"
+#include <algorithm>
+#include <functional>
+#include <tuple>
+
+TimerTableModel::TimerTableModel(TimerManager *manager, QObject *parent)
+    : QAbstractTableModel(parent), manager(manager)
+{
+    rebuildRows();
+
+    connect(manager, &TimerManager::timerAdded, this, &TimerTableModel::onTimerAdded);
+    connect(manager, &TimerManager::timersAdded, this, &TimerTableModel::onTimersAdded);
+    connect(manager, &TimerManager::timersRemoved, this, &TimerTableModel::onTimersRemoved);
+    connect(manager, &TimerManager::timersUpdated, this, &TimerTableModel::onTimersUpdated);
+    connect(manager, &TimerManager::groupsChanged, this, &TimerTableModel::onGroupsChanged);
+}
+
+int TimerTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rowIds.size();
+}
+
+int TimerTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+qint64 TimerTableModel::displayTenths(TimerDuration remaining, bool withTenths)
+{
+    return withTenths ? (remaining.count() + 99) / 100 : ceilSeconds(remaining) * 10;
+}
+
+QString TimerTableModel::formatTime(TimerDuration remaining, bool withTenths)
+{
+    qint64 tenths = displayTenths(remaining, withTenths);
+    qint64 totalSeconds = tenths / 10;
+    qint64 h = totalSeconds / 3600;
+    qint64 m = (totalSeconds % 3600) / 60;
+    qint64 s = totalSeconds % 60;
+    QString text = QString("%1:%2:%3")
+        .arg(h, 2, 10, QChar('0'))
+        .arg(m, 2, 10, QChar('0'))
+        .arg(s, 2, 10, QChar('0'));
+    if (withTenths) text += QString(".%1").arg(tenths % 10);
+    return text;
+}
+
+QString TimerTableModel::statusText(int flags)
+{
+    QString status = (flags & Ticking) ? QString("Біжить") : (flags & Running) ? QString("Група на паузі") : QString("Пауза");
+    if (flags & Repeats) status += " · повтор";
+    else if (flags & Scheduled) status += " · за розкладом";
+    return status;
+}
+
+QVariant TimerTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowIds.size())
+        return QVariant();
+
+    int id = rowIds[index.row()];
+    if (role == TimerIdRole)
+        return id;
+
+    if (role == Qt::CheckStateRole && index.column() == CheckColumn)
+        return checked.contains(id) ? Qt::Checked : Qt::Unchecked;
+
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole && role != RemainingRole && role != StatusFlagsRole)
+        return QVariant();
+
+    TimerView t = manager->getTimerById(id);
+    if (!t) return QVariant();
+
+    if (role == RemainingRole) return qint64(t.remaining().count());
+    if (role == StatusFlagsRole) {
+        int flags = 0;
+        if (t.running()) flags |= Running;
+        if (t.ticking()) flags |= Ticking;
+        if (t.duration().count() % 1000 != 0) flags |= WithTenths;
+        if (t.schedule().kind == TimerSchedule::Repeat) flags |= Repeats;
+        else if (t.schedule().kind == TimerSchedule::Calendar) flags |= Scheduled;
+        return flags;
+    }
+
+    if (role == Qt::ToolTipRole) {
+        if (index.column() != StatusColumn || t.schedule().kind != TimerSchedule::Calendar) return QVariant();
+        return QString("Розклад: %1").arg(t.schedule().cron.expression());
+    }
+
+    switch (index.column()) {
+    case NumberColumn: return index.row() + 1;
+    case NameColumn: return t.name();
+    case TimeColumn: return formatTime(t.remaining(), t.duration().count() % 1000 != 0);
+    case StatusColumn: return statusText(data(index, StatusFlagsRole).toInt());
+    default: return QVariant();
+    }
+}
+
+bool TimerTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || index.column() != CheckColumn || role != Qt::CheckStateRole)
+        return false;
+
+    int id = rowIds[index.row()];
+    if (value.toInt() == Qt::Checked) checked.insert(id);
+    else checked.remove(id);
+
+    emit dataChanged(index, index, {Qt::CheckStateRole});
+    emit checkedCountChanged(checked.size());
+    return true;
+}
+
+QVariant TimerTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QVariant();
+
+    static const char *labels[ColumnCount] = {"№", "Виділити", "Назва", "Час", "Статус", "Дії"};
+    return section >= 0 && section < ColumnCount ? QString(labels[section]) : QVariant();
+}
+
+Qt::ItemFlags TimerTableModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid()) return Qt::NoItemFlags;
+    if (index.column() == CheckColumn) return Qt::ItemIsEnabled | Qt::ItemIsUserCheckable;
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
+void TimerTableModel::clearChecked()
+{
+    if (checked.isEmpty()) return;
+
+    QSet<int> was;
+    was.swap(checked);
+    for (int id : was) {
+        int row = rowOf(id);
+        if (row >= 0) emit dataChanged(index(row, CheckColumn), index(row, CheckColumn), {Qt::CheckStateRole});
+    }
+    emit checkedCountChanged(0);
+}
+
+void TimerTableModel::setFilter(const QString &text)
+{
+    QString query = text.trimmed();
+    if (query == filterText) return;
+    filterText = query;
+
+    beginResetModel();
+    rebuildRows();
+    endResetModel();
+    uncheckHidden();
+}
+
+// Приховані таймери знімаються з виділення: пакетні дії стосуються лише видимих рядків
+void TimerTableModel::uncheckHidden()
+{
+    int before = checked.size();
+    for (auto it = checked.begin(); it != checked.end();)
+        it = rowById.contains(*it) ? std::next(it) : checked.erase(it);
+    if (checked.size() != before) emit checkedCountChanged(checked.size());
+}
+
+void TimerTableModel::setRowOrder(TimerTableModel::RowOrder rowOrder)
+{
+    if (rowOrder == order) return;
+    order = rowOrder;
+
+    beginResetModel();
+    rebuildRows();
+    endResetModel();
+}
+
+void TimerTableModel::rebuildRows()
+{
+    rowIds.clear();
+    rowById.clear();
+    runningIds.clear();
+
+    if (!filterText.isEmpty()) {
+        rowIds = manager->findTimers(filterText);
+        if (order == SoonestFirst)
+            std::sort(rowIds.begin(), rowIds.end(), [this](int a, int b) { return rowLess(a, b); });
+    } else if (order == SoonestFirst) {
+        rowIds = manager->timersBySoonest();
+    } else {
+        rowIds = manager->timerIds();
+    }
+
+    rowById.reserve(rowIds.size());
+    for (int row = 0; row < rowIds.size(); ++row) {
+        rowById.insert(rowIds[row], row);
+        if (manager->getTimerById(rowIds[row]).running()) runningIds.insert(rowIds[row]);
+    }
+    indexedRows = rowIds.size();
+}
+
+// Вставка чи видалення рядка лише опускає межу indexedRows: номери нижче неї вірні, а вище — переписуються
+// за один прохід при першому ж запиті. Тож пачка переставлень коштує одного переіндексування, а не по одному на рядок
+int TimerTableModel::rowOf(int id) const
+{
+    auto it = rowById.constFind(id);
+    if (it == rowById.constEnd()) return -1;
+    if (*it < indexedRows) return *it;
+    for (int r = indexedRows; r < rowIds.size(); ++r) rowById[rowIds[r]] = r;
+    indexedRows = rowIds.size();
+    return rowById.value(id);
+}
+
+// Той самий порядок, що й ExpiryOrder менеджера: ключі незмінних рядків не залежать від часу
+bool TimerTableModel::rowLess(int a, int b) const
+{
+    if (order == InsertionOrder) return a < b;
+
+    const TimerStorage &storage = manager->storage();
+    qint64 now = storage.nowMs();
+    auto key = [&](int id) {
+        int slot = manager->getTimerById(id).slot();
+        bool ticking = storage.isTicking(slot);
+        qint64 k = ticking ? storage.deadline(slot) - (storage.clockNow(slot, now) - now)
+                           : storage.remainingNow(slot, now).count();
+        return std::make_tuple(!ticking, k, id);
+    };
+    return key(a) < key(b);
+}
+
+// Рядки завжди впорядковані, тож таймер, що з'явився чи змінився, стає на своє місце
+void TimerTableModel::insertIdRow(int id)
+{
+    int row = int(std::lower_bound(rowIds.begin(), rowIds.end(), id,
+                                   [this](int a, int b) { return rowLess(a, b); }) - rowIds.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    rowIds.insert(row, id);
+    rowById.insert(id, row);
+    indexedRows = qMin(indexedRows, row);
+    endInsertRows();
+}
+
+void TimerTableModel::takeRow(int row, bool forget)
+{
+    int id = rowIds[row];
+    beginRemoveRows(QModelIndex(), row, row);
+    rowIds.remove(row);
+    rowById.remove(id);
+    indexedRows = qMin(indexedRows, row);
+    endRemoveRows();
+
+    if (!forget) return;
+    runningIds.remove(id);
+    if (checked.remove(id)) emit checkedCountChanged(checked.size());
+}
+
+// Таймери з групою на паузі стоять — їхні клітинки не чіпаємо
+void TimerTableModel::refreshRunning()
+{
+    if (suspended) return;
+    const TimerStorage &storage = manager->storage();
+    for (int id : runningIds) {
+        TimerView t = manager->getTimerById(id);
+        if (t && storage.isTicking(t.slot())) emitRowChanged(id, TimeColumn, TimeColumn);
+    }
+}
+
+void TimerTableModel::setSuspended(bool value)
+{
+    if (value == suspended) return;
+    suspended = value;
+    if (suspended) return;
+
+    // Перейменування, пропущені під час призупинення, могли вивести таймери з фільтра
+    if (orderStale) {
+        orderStale = false;
+        beginResetModel();
+        rebuildRows();
+        endResetModel();
+        uncheckHidden();
+    } else if (!rowIds.isEmpty()) {
+        emit dataChanged(index(0, NumberColumn), index(rowIds.size() - 1, StatusColumn),
+                         {Qt::DisplayRole, RemainingRole, StatusFlagsRole});
+    }
+}
+
+void TimerTableModel::emitRowChanged(int id, int firstColumn, int lastColumn)
+{
+    if (suspended) return;
+    int row = rowOf(id);
+    if (row < 0) return;
+    emit dataChanged(index(row, firstColumn), index(row, lastColumn), {Qt::DisplayRole, RemainingRole, StatusFlagsRole});
+}
+
+void TimerTableModel::onTimerAdded(int id)
+{
+    if (!filterText.isEmpty() && !NameIndex::matches(manager->getTimerById(id).name(), filterText)) return;
+    if (order == SoonestFirst) {
+        insertIdRow(id);
+        return;
+    }
+
+    int row = rowIds.size();
+    beginInsertRows(QModelIndex(), row, row);
+    rowIds.append(id);
+    rowById.insert(id, row);
+    if (indexedRows == row) indexedRows = rowIds.size();
+    endInsertRows();
+}
+
+// Нові id більші за всі наявні, тож у порядку додавання пачка лягає одним діапазоном у кінець
+void TimerTableModel::onTimersAdded(const QVector<int> &ids)
+{
+    if (order == SoonestFirst || !filterText.isEmpty()) {
+        beginResetModel();
+        rebuildRows();
+        endResetModel();
+        return;
+    }
+
+    int first = rowIds.size();
+    beginInsertRows(QModelIndex(), first, first + ids.size() - 1);
+    rowIds.append(ids);
+    rowById.reserve(rowIds.size());
+    for (int row = first; row < rowIds.size(); ++row) rowById.insert(rowIds[row], row);
+    if (indexedRows == first) indexedRows = rowIds.size();
+    endInsertRows();
+}
+
+void TimerTableModel::onTimersRemoved(const QVector<int> &ids)
+{
+    // Спершу всі рядки, потім видалення: rowOf може переіндексувати хвіст і повернути в rowById
+    // id, які цей цикл уже прибрав
+    QVector<int> rows;
+    QVector<int> found;
+    rows.reserve(ids.size());
+    found.reserve(ids.size());
+    for (int id : ids) {
+        int row = rowOf(id);
+        if (row < 0) continue;
+        rows.append(row);
+        found.append(id);
+    }
+    if (rows.isEmpty()) return;
+
+    bool checkedChanged = false;
+    for (int id : found) {
+        rowById.remove(id);
+        runningIds.remove(id);
+        checkedChanged |= checked.remove(id);
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    // Кілька суцільних діапазонів знімаємо по одному з кінця, а велике розсіяне
+    // видалення робимо одним ущільненням зі скиданням моделі
+    int ranges = 1;
+    for (int i = 1; i < rows.size(); ++i) {
+        if (rows[i] != rows[i - 1] + 1) ++ranges;
+    }
+
+    if (ranges <= 8) {
+        int last = rows.size() - 1;
+        while (last >= 0) {
+            int first = last;
+            while (first > 0 && rows[first - 1] == rows[first] - 1) --first;
+            beginRemoveRows(QModelIndex(), rows[first], rows[last]);
+            rowIds.remove(rows[first], rows[last] - rows[first] + 1);
+            endRemoveRows();
+            last = first - 1;
+        }
+    } else {
+        beginResetModel();
+        int out = rows.first();
+        int next = 0;
+        for (int r = rows.first(); r < rowIds.size(); ++r) {
+            if (next < rows.size() && rows[next] == r) { ++next; continue; }
+            rowIds[out++] = rowIds[r];
+        }
+        rowIds.resize(out);
+        endResetModel();
+    }
+
+    indexedRows = qMin(indexedRows, rows.first());
+
+    if (checkedChanged) emit checkedCountChanged(checked.size());
+}
+
+// Годинник групи змінює залишок і стан усіх її таймерів одразу
+void TimerTableModel::onGroupsChanged()
+{
+    if (suspended) {
+        orderStale |= order == SoonestFirst;
+    } else if (order == SoonestFirst) {
+        beginResetModel();
+        rebuildRows();
+        endResetModel();
+    } else if (!rowIds.isEmpty()) {
+        emit dataChanged(index(0, TimeColumn), index(rowIds.size() - 1, StatusColumn),
+                         {Qt::DisplayRole, RemainingRole, StatusFlagsRole});
+    }
+}
+
+void TimerTableModel::onTimersUpdated(const QVector<int> &ids)
+{
+    // Зміна стану зсуває ключ рядка: кілька рядків переставляємо, велику пачку — одним перебудуванням.
+    // Призупинена модель нічого не переставляє — рядки перебудуються при продовженні
+    if (order == SoonestFirst && suspended) {
+        orderStale = true;
+        return;
+    }
+    if (order == SoonestFirst && ids.size() > 64) {
+        beginResetModel();
+        rebuildRows();
+        endResetModel();
+        return;
+    }
+
+    // Спершу знімаються рядки, що зникають або переставляються, — від останнього, тож номери ще не знятих
+    // не зсуваються. Рядок, що лишається у фільтрі, не втрачає виділення — нижче він стане на нове місце
+    QVector<QPair<int, bool>> taken;    // рядок, чи зняти й виділення
+    for (int id : ids) {
+        TimerView t = manager->getTimerById(id);
+        int row = rowOf(id);
+        if (!t || row < 0) continue;
+        // Перейменування може ввести таймер у фільтр або вивести з нього
+        bool match = filterText.isEmpty() || NameIndex::matches(t.name(), filterText);
+        if (!match || order == SoonestFirst) taken.append({row, !match});
+    }
+    std::sort(taken.begin(), taken.end(), std::greater<QPair<int, bool>>());
+    for (const QPair<int, bool> &r : taken) takeRow(r.first, r.second);
+
+    for (int id : ids) {
+        TimerView t = manager->getTimerById(id);
+        if (t && !rowById.contains(id) && (filterText.isEmpty() || NameIndex::matches(t.name(), filterText)))
+            insertIdRow(id);
+    }
+
+    for (int id : ids) {
+        TimerView t = manager->getTimerById(id);
+        if (!t || !rowById.contains(id)) continue;
+        if (t.running()) runningIds.insert(id);
+        else runningIds.remove(id);
+        emitRowChanged(id, NameColumn, StatusColumn);
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef TIMERTABLEMODEL_H
+#define TIMERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QHash>
+#include <QSet>
+#include "TimerManager.h"
+
+// Модель таблиці таймерів поверх TimerManager.
+// Рядки не перебудовуються: на кожну зміну шлеться dataChanged лише для зачеплених клітинок.
+class TimerTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        NumberColumn,
+        CheckColumn,
+        NameColumn,
+        TimeColumn,
+        StatusColumn,
+        ActionsColumn,
+        ColumnCount
+    };
+
+    // Сирі значення для делегата, що малює час і статус без форматування рядків
+    enum Role {
+        TimerIdRole = Qt::UserRole + 1,
+        RemainingRole,      // залишок, мс (qint64)
+        StatusFlagsRole     // StatusFlag
+    };
+
+    enum StatusFlag {
+        Running = 0x1,
+        Ticking = 0x2,      // запущений і годинник групи йде
+        WithTenths = 0x4,   // тривалість з мілісекундами — час показується з десятими
+        Repeats = 0x8,
+        Scheduled = 0x10
+    };
+
+    enum RowOrder {
+        InsertionOrder,
+        SoonestFirst    // запущені за дедлайном, далі на паузі за залишком
+    };
+
+    explicit TimerTableModel(TimerManager *manager, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    int timerIdAt(int row) const { return rowIds.value(row, -1); }
+
+    // Виділення зберігається за id таймера, а не за номером рядка
+    QList<int> checkedIds() const { return checked.values(); }
+    int checkedCount() const { return checked.size(); }
+    void clearChecked();
+
+    // Цілі секунди округлюються вгору; з withTenths — до десятих (для таймерів з мілісекундною тривалістю)
+    static QString formatTime(TimerDuration remaining, bool withTenths = false);
+    static qint64 displayTenths(TimerDuration remaining, bool withTenths);  // показаний час у десятих секунди
+    static QString statusText(int flags);
+
+    QString filter() const { return filterText; }
+    RowOrder rowOrder() const { return order; }
+    bool isSuspended() const { return suspended; }
+
+public slots:
+    // Лишає лише таймери, назва яких містить текст (без урахування регістру); порожній — усі
+    void setFilter(const QString &text);
+
+    // Порядок "спершу найближчі" ведеться без пересортування на тік: рядок переставляється,
+    // лише коли змінюється стан його таймера
+    void setRowOrder(TimerTableModel::RowOrder order);
+
+    // Оновлює лише клітинки часу таймерів, відлік яких справді йде
+    void refreshRunning();
+
+    // Поки вікно сховане, модель стежить лише за складом рядків: клітинки не оновлюються,
+    // порядок "спершу найближчі" не підтримується. Продовження — одне оновлення всього видимого
+    void setSuspended(bool suspended);
+
+signals:
+    void checkedCountChanged(int count);
+
+private slots:
+    void onTimerAdded(int id);
+    void onTimersAdded(const QVector<int> &ids);
+    void onTimersRemoved(const QVector<int> &ids);
+    void onTimersUpdated(const QVector<int> &ids);
+    void onGroupsChanged();
+
+private:
+    TimerManager *manager;
+    QVector<int> rowIds;
+    mutable QHash<int, int> rowById;    // id -> рядок; номери від indexedRows можуть бути застарілі
+    mutable int indexedRows = 0;
+    QSet<int> checked;
+    QSet<int> runningIds;
+    QString filterText;
+    RowOrder order = InsertionOrder;
+    bool suspended = false;
+    bool orderStale = false;
+
+    void rebuildRows();
+    void uncheckHidden();
+    void insertIdRow(int id);
+    void takeRow(int row, bool forget);     // forget — зняти й виділення
+    int rowOf(int id) const;
+    bool rowLess(int a, int b) const;
+    void emitRowChanged(int id, int firstColumn, int lastColumn);
+};
+
+#endif // TIMERTABLEMODEL_H
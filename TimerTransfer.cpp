@@ -0,0 +1,475 @@
+#include "TimerTransfer.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <climits>
+#include <cmath>
+#include <deque>
+#include <future>
+#include <memory>
+
+namespace TimerTransfer {
+
+namespace {
+
+using NewTimer = TimerManager::NewTimer;
+
+const qint64 ChunkSize = 4 << 20;
+const int FlushSize = 1 << 20;
+
+struct Columns {
+    char separator = ',';
+    int name = 0;
+    int duration = 1;
+    int schedule = 2;
+    bool durationMs = false;
+};
+
+struct ParsedChunk : Chunk {
+    int invalid = 0;
+    QStringList errors;
+};
+
+// Одна CSV-запис від p до неекранованого кінця рядка; p переходить на початок наступної.
+// lines — скільки переведень рядка спожито (у полі в лапках їх може бути кілька)
+void readCsvRecord(const char *&p, const char *end, char sep, QVector<QByteArray> &fields, int &lines)
+{
+    fields.clear();
+    QByteArray field;
+    bool quoted = false;
+    bool wasQuoted = false;
+    lines = 0;
+    while (p < end) {
+        char c = *p++;
+        if (quoted) {
+            if (c == '"') {
+                if (p < end && *p == '"') { field += '"'; ++p; }
+                else quoted = false;
+            } else {
+                if (c == '\n') ++lines;
+                field += c;
+            }
+        } else if (c == '"' && field.isEmpty() && !wasQuoted) {
+            quoted = wasQuoted = true;
+        } else if (c == sep) {
+            fields.append(wasQuoted ? field : field.trimmed());
+            field.clear();
+            wasQuoted = false;
+        } else if (c == '\n') {
+            ++lines;
+            break;
+        } else if (c != '\r') {
+            field += c;
+        }
+    }
+    fields.append(wasQuoted ? field : field.trimmed());
+}
+
+// "ГГ:ХХ:СС[.ммм]", "ХХ:СС" або ціле число секунд; inMs — ціле число мілісекунд
+bool parseDuration(const QString &text, bool inMs, TimerDuration &out)
+{
+    bool ok = false;
+    if (inMs) {
+        out = TimerDuration(text.toLongLong(&ok));
+        return ok;
+    }
+    if (!text.contains(':')) {
+        out = std::chrono::seconds(text.toLongLong(&ok));
+        return ok;
+    }
+
+    const QStringList parts = text.split(':');
+    if (parts.size() > 3) return false;
+    qint64 minutes = 0;
+    for (int i = 0; i < parts.size() - 1; ++i) {
+        qint64 v = parts[i].toLongLong(&ok);
+        if (!ok || v < 0) return false;
+        minutes = minutes * 60 + v;
+    }
+    double seconds = parts.last().toDouble(&ok);
+    if (!ok || seconds < 0) return false;
+    out = TimerDuration(minutes * 60000 + qRound64(seconds * 1000));
+    return true;
+}
+
+bool parseSchedule(const QString &text, TimerSchedule &out, QString &error)
+{
+    QString s = text.trimmed();
+    if (s.isEmpty() || s.compare("once", Qt::CaseInsensitive) == 0) {
+        out = TimerSchedule::once();
+    } else if (s.compare("repeat", Qt::CaseInsensitive) == 0) {
+        out = TimerSchedule::repeat();
+    } else {
+        CronSchedule cron = CronSchedule::parse(s, &error);
+        if (!cron.isValid()) return false;
+        out = TimerSchedule::calendar(cron);
+    }
+    return true;
+}
+
+QString scheduleText(const TimerSchedule &schedule)
+{
+    switch (schedule.kind) {
+    case TimerSchedule::Repeat: return "repeat";
+    case TimerSchedule::Calendar: return schedule.cron.expression();
+    default: return QString();
+    }
+}
+
+void addError(ParsedChunk &chunk, int line, const QString &message)
+{
+    ++chunk.invalid;
+    if (chunk.errors.size() < MaxErrors) chunk.errors.append(QString("Рядок %1: %2").arg(line).arg(message));
+}
+
+bool makeTimer(ParsedChunk &chunk, int line, const QString &name, const QString &duration, bool durationMs,
+               const QString &schedule)
+{
+    NewTimer t;
+    t.name = name.trimmed();
+    QString error;
+    if (t.name.isEmpty()) { addError(chunk, line, "порожня назва"); return false; }
+    if (!parseSchedule(schedule, t.schedule, error)) { addError(chunk, line, error); return false; }
+    if (!(duration.isEmpty() && t.schedule.kind == TimerSchedule::Calendar)
+        && !parseDuration(duration.trimmed(), durationMs, t.duration)) {
+        addError(chunk, line, QString("некоректна тривалість \"%1\"").arg(duration));
+        return false;
+    }
+    chunk.timers.append(t);
+    chunk.lines.append(line);
+    return true;
+}
+
+ParsedChunk parseCsvChunk(const QByteArray &data, int firstLine, const Columns &columns)
+{
+    ParsedChunk chunk;
+    chunk.timers.reserve(data.size() / 24);
+    chunk.lines.reserve(data.size() / 24);
+
+    QVector<QByteArray> fields;
+    const char *p = data.constData();
+    const char *end = p + data.size();
+    int line = firstLine;
+    while (p < end) {
+        int consumed;
+        readCsvRecord(p, end, columns.separator, fields, consumed);
+        int recordLine = line;
+        line += consumed;
+        if (fields.size() == 1 && fields[0].isEmpty()) continue;
+
+        auto field = [&fields](int column) {
+            return column >= 0 && column < fields.size() ? QString::fromUtf8(fields[column]) : QString();
+        };
+        makeTimer(chunk, recordLine, field(columns.name), field(columns.duration), columns.durationMs,
+                  field(columns.schedule));
+    }
+    return chunk;
+}
+
+ParsedChunk parseJsonChunk(const QByteArray &data, int firstLine)
+{
+    ParsedChunk chunk;
+    int line = firstLine;
+    qsizetype start = 0;
+    while (start < data.size()) {
+        qsizetype nl = data.indexOf('\n', start);
+        if (nl < 0) nl = data.size();
+        QByteArray text = QByteArray::fromRawData(data.constData() + start, nl - start).trimmed();
+        int recordLine = line++;
+        start = nl + 1;
+        if (text.isEmpty()) continue;
+
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(text, &parseError);
+        if (!doc.isObject()) {
+            addError(chunk, recordLine, parseError.error != QJsonParseError::NoError ? parseError.errorString()
+                                                                                     : QString("очікувався об'єкт"));
+            continue;
+        }
+
+        QJsonObject o = doc.object();
+        QString name = o.contains("name") ? o.value("name").toString() : o.value("назва").toString();
+        QString duration;
+        bool durationMs = o.contains("duration_ms");
+        QJsonValue d = durationMs ? o.value("duration_ms") : o.contains("duration") ? o.value("duration") : o.value("тривалість");
+        if (d.isDouble()) {
+            // toInteger() дає 0 для дробових чисел — 1.5 інакше стало б нульовою тривалістю
+            double v = d.toDouble();
+            if (v != std::floor(v) || std::abs(v) > 9e15) {
+                addError(chunk, recordLine, QString("тривалість має бути цілим числом: %1").arg(v));
+                continue;
+            }
+            duration = QString::number(qint64(v));
+        } else if (d.isString()) {
+            duration = d.toString();
+        }
+        QString schedule = o.contains("schedule") ? o.value("schedule").toString() : o.value("розклад").toString();
+        makeTimer(chunk, recordLine, name, duration, durationMs, schedule);
+    }
+    return chunk;
+}
+
+// Перший рядок CSV визначає роздільник і, якщо це заголовок, колонки. Повертає довжину заголовка в байтах
+qsizetype detectColumns(const QByteArray &head, Columns &columns)
+{
+    qsizetype firstEnd = head.indexOf('\n');
+    QByteArray first = head.left(firstEnd < 0 ? head.size() : firstEnd);
+    columns.separator = first.contains(';') && !first.contains(',') ? ';' : ',';
+
+    QVector<QByteArray> fields;
+    int lines;
+    const char *p = head.constData();
+    readCsvRecord(p, head.constData() + head.size(), columns.separator, fields, lines);
+
+    Columns found;
+    found.separator = columns.separator;
+    found.name = found.duration = found.schedule = -1;
+    for (int i = 0; i < fields.size(); ++i) {
+        QString h = QString::fromUtf8(fields[i]).trimmed().toLower();
+        if (h == "name" || h == "назва") found.name = i;
+        else if (h == "duration_ms") { found.duration = i; found.durationMs = true; }
+        else if ((h == "duration" || h == "тривалість") && !found.durationMs) found.duration = i;
+        else if (h == "schedule" || h == "розклад") found.schedule = i;
+    }
+    if (found.name < 0) return 0;
+    columns = found;
+    return p - head.constData();
+}
+
+} // namespace
+
+Format formatOf(const QString &path)
+{
+    QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "jsonl" || suffix == "ndjson" || suffix == "json" ? JsonLines : Csv;
+}
+
+ParseResult parseFile(const QString &path, Format format, const std::function<void(const Chunk &)> &sink)
+{
+    ParseResult result;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.error = file.errorString();
+        return result;
+    }
+
+    Columns columns;
+    QThreadPool *pool = QThreadPool::globalInstance();
+    const size_t window = size_t(qMax(2, 2 * pool->maxThreadCount()));
+    std::deque<std::future<ParsedChunk>> inFlight;
+
+    // Блоки віддаються в порядку файлу, тож порядок таймерів і номери рядків зберігаються
+    auto collect = [&]() {
+        ParsedChunk chunk = inFlight.front().get();
+        inFlight.pop_front();
+        result.parsed += chunk.timers.size();
+        result.invalid += chunk.invalid;
+        if (!chunk.timers.isEmpty()) sink(chunk);
+        for (const QString &e : chunk.errors) {
+            if (result.errors.size() < MaxErrors) result.errors.append(e);
+        }
+    };
+    auto submit = [&](QByteArray data, int firstLine) {
+        if (inFlight.size() >= window) collect();
+        auto promise = std::make_shared<std::promise<ParsedChunk>>();
+        inFlight.push_back(promise->get_future());
+        pool->start(QRunnable::create([promise, data, firstLine, columns, format]() {
+            ParsedChunk chunk = format == Csv ? parseCsvChunk(data, firstLine, columns) : parseJsonChunk(data, firstLine);
+            chunk.bytes = data.size();
+            promise->set_value(std::move(chunk));
+        }));
+    };
+
+    QByteArray carry;
+    int line = 1;
+    bool first = true;
+    while (true) {
+        QByteArray block = carry + file.read(ChunkSize);
+        bool atEnd = file.atEnd();
+        if (block.isEmpty()) break;
+
+        if (first) {
+            first = false;
+            if (block.startsWith("\xEF\xBB\xBF")) block.remove(0, 3);  // BOM з електронних таблиць
+            if (format == Csv) {
+                qsizetype header = detectColumns(block, columns);
+                if (header > 0) {
+                    block.remove(0, header);
+                    ++line;
+                }
+            }
+        }
+
+        // Блок ріжеться на останньому переведенні рядка поза лапками; хвіст іде в наступний блок
+        qsizetype split = block.size();
+        int lines = 0;
+        if (!atEnd) {
+            split = 0;
+            int counted = 0;
+            bool quoted = false;
+            const char *data = block.constData();
+            for (qsizetype i = 0; i < block.size(); ++i) {
+                char c = data[i];
+                if (c == '"' && format == Csv) quoted = !quoted;
+                else if (c == '\n') {
+                    ++counted;
+                    if (!quoted) { split = i + 1; lines = counted; }
+                }
+            }
+            if (split == 0) {
+                // Жодного цілого рядка — читаємо далі
+                carry = block;
+                continue;
+            }
+        } else {
+            lines = int(block.count('\n'));
+        }
+
+        carry = block.mid(split);
+        block.truncate(split);
+        submit(block, line);
+        line += lines;
+        if (atEnd) break;
+    }
+    while (!inFlight.empty()) collect();
+    return result;
+}
+
+ImportResult importFile(TimerManager *manager, const QString &path, Format format)
+{
+    ImportResult result;
+    const qint64 fileSize = QFileInfo(path).size();
+    bool adding = false;
+    QStringList rejectedErrors;
+    QVector<int> rejected;
+
+    ParseResult parsed = parseFile(path, format, [&](const Chunk &chunk) {
+        if (!adding) {
+            // Решта файлу оцінюється за щільністю рядків першого блоку
+            qint64 expected = fileSize * chunk.timers.size() / qMax<qint64>(1, chunk.bytes);
+            manager->beginAdding(int(qBound<qint64>(chunk.timers.size(), expected, INT_MAX / 2)));
+            adding = true;
+        }
+        rejected.clear();
+        result.added += manager->addTimers(chunk.timers, &rejected).size();
+        result.rejected += rejected.size();
+        for (int index : rejected) {
+            if (rejectedErrors.size() >= MaxErrors) break;
+            rejectedErrors.append(QString("Рядок %1: назва \"%2\" вже зайнята або тривалість нульова")
+                                      .arg(chunk.lines[index]).arg(chunk.timers[index].name));
+        }
+    });
+    if (adding) manager->endAdding();
+
+    result.error = parsed.error;
+    result.errors = parsed.errors;
+    result.rejected += parsed.invalid;
+    for (const QString &e : rejectedErrors) {
+        if (result.errors.size() >= MaxErrors) break;
+        result.errors.append(e);
+    }
+    return result;
+}
+
+namespace {
+
+void putCsvField(QByteArray &out, const QByteArray &utf8)
+{
+    bool quote = utf8.contains(',') || utf8.contains('"') || utf8.contains('\n') || utf8.contains('\r')
+                 || utf8.contains(';') || (!utf8.isEmpty() && (utf8.front() == ' ' || utf8.back() == ' '));
+    if (!quote) {
+        out += utf8;
+        return;
+    }
+    out += '"';
+    for (char c : utf8) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+void putJsonString(QByteArray &out, const QByteArray &utf8)
+{
+    static const char hex[] = "0123456789abcdef";
+    out += '"';
+    for (char c : utf8) {
+        uchar u = uchar(c);
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if (c == '\n') out += "\\n";
+        else if (c == '\t') out += "\\t";
+        else if (c == '\r') out += "\\r";
+        else if (u < 0x20) { out += "\\u00"; out += hex[u >> 4]; out += hex[u & 15]; }
+        else out += c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+bool exportFile(const TimerManager *manager, const QString &path, Format format, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    QByteArray out;
+    out.reserve(FlushSize + 4096);
+    if (format == Csv) out += "id,name,duration_ms,remaining_ms,running,schedule,group\n";
+
+    for (int id : manager->timerIds()) {
+        TimerView t = manager->getTimerById(id);
+        QByteArray name = t.name().toUtf8();
+        QByteArray schedule = scheduleText(t.schedule()).toUtf8();
+        if (format == Csv) {
+            out += QByteArray::number(id);
+            out += ',';
+            putCsvField(out, name);
+            out += ',';
+            out += QByteArray::number(t.duration().count());
+            out += ',';
+            out += QByteArray::number(t.remaining().count());
+            out += t.running() ? ",1," : ",0,";
+            putCsvField(out, schedule);
+            out += ',';
+            out += QByteArray::number(t.group());
+        } else {
+            out += "{\"id\":";
+            out += QByteArray::number(id);
+            out += ",\"name\":";
+            putJsonString(out, name);
+            out += ",\"duration_ms\":";
+            out += QByteArray::number(t.duration().count());
+            out += ",\"remaining_ms\":";
+            out += QByteArray::number(t.remaining().count());
+            out += t.running() ? ",\"running\":true" : ",\"running\":false";
+            out += ",\"schedule\":";
+            putJsonString(out, schedule);
+            out += ",\"group\":";
+            out += QByteArray::number(t.group());
+            out += '}';
+        }
+        out += '\n';
+
+        if (out.size() >= FlushSize) {
+            if (file.write(out) != out.size()) {
+                if (error) *error = file.errorString();
+                return false;
+            }
+            out.clear();
+        }
+    }
+
+    if (file.write(out) != out.size() || !file.flush()) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+} // namespace TimerTransfer
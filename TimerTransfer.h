@@ -0,0 +1,64 @@
+#ifndef TIMERTRANSFER_H
+#define TIMERTRANSFER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "TimerManager.h"
+#include <functional>
+
+// Потоковий імпорт і експорт таймерів у CSV і JSON Lines.
+//
+// CSV: роздільник — кома або крапка з комою (за першим рядком), лапки за RFC 4180. Якщо перший рядок —
+// заголовок, колонки шукаються за назвами name/назва, duration_ms, duration/тривалість, schedule/розклад;
+// інакше колонки за порядком: назва, тривалість, розклад. JSON Lines: по об'єкту на рядок з тими самими ключами.
+// Тривалість — "ГГ:ХХ:СС[.ммм]" або ціле число секунд; duration_ms — мілісекунди.
+// Розклад — порожній або "once", "repeat" чи вираз cron. Експортовані файли імпортуються назад
+namespace TimerTransfer {
+
+enum Format {
+    Csv,
+    JsonLines
+};
+
+// .jsonl, .ndjson і .json — JSON Lines, решта — CSV
+Format formatOf(const QString &path);
+
+// Розібраний блок файлу
+struct Chunk {
+    QVector<TimerManager::NewTimer> timers;
+    QVector<int> lines;     // рядок файлу кожного таймера — для повідомлень про відхилені
+    qint64 bytes = 0;       // скільки байтів файлу займав блок
+};
+
+struct ParseResult {
+    int parsed = 0;         // таймерів, переданих у sink
+    int invalid = 0;        // рядків, що не розібрались
+    QStringList errors;     // перші MaxErrors повідомлень
+    QString error;          // файл не прочитано взагалі
+};
+
+struct ImportResult {
+    int added = 0;
+    int rejected = 0;       // не розібрались або відхилені менеджером
+    QStringList errors;
+    QString error;
+};
+
+constexpr int MaxErrors = 100;
+
+// Файл читається блоками; блоки розбираються паралельно в глобальному пулі потоків,
+// і в польоті їх не більше двох на потік. Розібрані блоки віддаються в sink у порядку файлу
+// в потоці виклику й ніде не накопичуються — пам'ять не залежить від розміру файлу
+ParseResult parseFile(const QString &path, Format format, const std::function<void(const Chunk &)> &sink);
+
+// Розбір з додаванням кожного блоку, щойно він готовий: один резерв за щільністю першого блоку
+// і одне сповіщення timersAdded наприкінці
+ImportResult importFile(TimerManager *manager, const QString &path, Format format);
+
+// Поточний стан усіх таймерів: id, назва, тривалість і залишок (мс), запущено, розклад, група
+bool exportFile(const TimerManager *manager, const QString &path, Format format, QString *error = nullptr);
+
+} // namespace TimerTransfer
+
+#endif // TIMERTRANSFER_H
@@ -0,0 +1,151 @@
+#include "TimingWheel.h"
+#include <QtAlgorithms>
+
+TimingWheel::TimingWheel(Tick now)
+    : freeHead(-1), current(now), count(0)
+{
+    for (int &h : heads) h = -1;
+    for (quint64 &o : occupied) o = 0;
+}
+
+int TimingWheel::allocNode()
+{
+    if (freeHead != -1) {
+        int n = freeHead;
+        freeHead = nodes[n].next;
+        return n;
+    }
+    nodes.append(Node{0, 0, -1, -1, -1});
+    return nodes.size() - 1;
+}
+
+void TimingWheel::freeNode(int node)
+{
+    nodes[node].list = -1;
+    nodes[node].prev = -1;
+    nodes[node].next = freeHead;
+    freeHead = node;
+}
+
+int TimingWheel::schedule(Tick expiry, int payload)
+{
+    int n = allocNode();
+    // Прострочені дедлайни спрацьовують на найближчому тіку
+    nodes[n].expiry = qMax(expiry, current + 1);
+    nodes[n].payload = payload;
+    link(n);
+    ++count;
+    return n;
+}
+
+void TimingWheel::cancel(int node)
+{
+    if (node < 0 || node >= nodes.size() || nodes[node].list == -1)
+        return;
+    unlink(node);
+    freeNode(node);
+    --count;
+}
+
+void TimingWheel::link(int node)
+{
+    Node &n = nodes[node];
+    Tick diff = n.expiry ^ current;
+
+    // Рівень визначається найстаршою групою бітів, у якій дедлайн відрізняється від поточного тіку
+    int list = OverflowList;
+    for (int level = 0; level < LevelCount; ++level) {
+        if ((diff >> (SlotBits * (level + 1))) == 0) {
+            int slot = int((n.expiry >> (SlotBits * level)) & SlotMask);
+            list = level * SlotCount + slot;
+            occupied[level] |= quint64(1) << slot;
+            break;
+        }
+    }
+
+    n.list = list;
+    n.prev = -1;
+    n.next = heads[list];
+    if (n.next != -1) nodes[n.next].prev = node;
+    heads[list] = node;
+}
+
+void TimingWheel::unlink(int node)
+{
+    Node &n = nodes[node];
+    if (n.prev != -1) nodes[n.prev].next = n.next;
+    else heads[n.list] = n.next;
+    if (n.next != -1) nodes[n.next].prev = n.prev;
+
+    if (heads[n.list] == -1 && n.list != OverflowList) {
+        occupied[n.list / SlotCount] &= ~(quint64(1) << (n.list % SlotCount));
+    }
+}
+
+void TimingWheel::relinkList(int list)
+{
+    int n = heads[list];
+    heads[list] = -1;
+    if (list != OverflowList)
+        occupied[list / SlotCount] &= ~(quint64(1) << (list % SlotCount));
+
+    while (n != -1) {
+        int next = nodes[n].next;
+        link(n);
+        n = next;
+    }
+}
+
+TimingWheel::Tick TimingWheel::nextEventTick() const
+{
+    if (count == 0) return NoTick;
+
+    // Перший непорожній рівень завжди дає найближчу подію:
+    // слоти вищих рівнів лежать за межами поточного блоку нижчого
+    for (int level = 0; level < LevelCount; ++level) {
+        int shift = SlotBits * level;
+        int group = int((current >> shift) & SlotMask);
+        quint64 mask = occupied[level] & ~((quint64(2) << group) - 1);
+        if (mask) {
+            Tick slot = qCountTrailingZeroBits(mask);
+            Tick base = (current >> (shift + SlotBits)) << (shift + SlotBits);
+            return base | (slot << shift);
+        }
+    }
+
+    // Лишилися тільки вузли з переповнення — чекаємо початку наступного верхнього блоку
+    const int topShift = SlotBits * LevelCount;
+    return ((current >> topShift) + 1) << topShift;
+}
+
+void TimingWheel::advance(Tick now, QVector<int> &expired)
+{
+    while (count > 0) {
+        Tick t = nextEventTick();
+        if (t > now) break;
+        current = t;
+
+        // Каскад згори донизу: перерозподілені вузли можуть потрапити в поточний слот нижчого рівня
+        if ((t & ((Tick(1) << (SlotBits * LevelCount)) - 1)) == 0)
+            relinkList(OverflowList);
+        for (int level = LevelCount - 1; level > 0; --level) {
+            int shift = SlotBits * level;
+            if ((t & ((Tick(1) << shift) - 1)) == 0)
+                relinkList(level * SlotCount + int((t >> shift) & SlotMask));
+        }
+
+        int list = int(t & SlotMask);
+        int n = heads[list];
+        heads[list] = -1;
+        occupied[0] &= ~(quint64(1) << list);
+        while (n != -1) {
+            int next = nodes[n].next;
+            expired.append(nodes[n].payload);
+            freeNode(n);
+            --count;
+            n = next;
+        }
+    }
+
+    if (now > current) current = now;
+}
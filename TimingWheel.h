@@ -0,0 +1,65 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// Ієрархічне колесо таймерів.
+// Кожен рівень має 64 слоти: рівень 0 — окремі тіки (мілісекунди),
+// кожен наступний — блоки у 64 рази довші (~0.06 с, ~4 с, ~4.5 хв, ~4.7 год, ~12 діб).
+// Далі — список переповнення.
+// Вставка, скасування і спрацювання коштують O(1).
+class TimingWheel
+{
+public:
+    using Tick = quint64;
+
+    explicit TimingWheel(Tick now = 0);
+
+    // Повертає номер вузла, який потрібен для cancel()
+    int schedule(Tick expiry, int payload);
+    void cancel(int node);
+
+    // Просуває колесо до тіку now, payload усіх вузлів, що спрацювали, додаються в expired
+    void advance(Tick now, QVector<int> &expired);
+
+    bool isEmpty() const { return count == 0; }
+    qint64 memoryBytes() const { return qint64(sizeof(*this)) + nodes.capacity() * qint64(sizeof(Node)); }
+    int size() const { return count; }
+    Tick currentTick() const { return current; }
+    Tick expiryOf(int node) const { return nodes[node].expiry; }
+
+    // Найближчий тік, на якому колесу є що робити (спрацювання або каскад)
+    Tick nextEventTick() const;
+
+private:
+    static constexpr int SlotBits = 6;
+    static constexpr int SlotCount = 1 << SlotBits;
+    static constexpr int SlotMask = SlotCount - 1;
+    static constexpr int LevelCount = 6;
+    static constexpr int OverflowList = LevelCount * SlotCount;
+    static constexpr Tick NoTick = ~Tick(0);
+
+    struct Node {
+        Tick expiry;
+        int payload;
+        int prev;
+        int next;
+        int list;   // -1 для вільного вузла
+    };
+
+    QVector<Node> nodes;
+    int freeHead;
+    int heads[LevelCount * SlotCount + 1];
+    quint64 occupied[LevelCount];
+    Tick current;
+    int count;
+
+    int allocNode();
+    void freeNode(int node);
+    void link(int node);
+    void unlink(int node);
+    void relinkList(int list);
+};
+
+#endif // TIMINGWHEEL_H
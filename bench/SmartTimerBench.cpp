@@ -0,0 +1,326 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "TimerManager.h"
+#include "TimerStore.h"
+#include "TimerTableModel.h"
+#include "TimerTransfer.h"
+#include "TimerHistory.h"
+#include "TimingWheel.h"
+#include "Clock.h"
+
+// Бенчмарки ядра на 1k / 10k / 100k / 1M таймерів.
+// Машинний формат: SmartTimerBench -o results.xml,xml (або csv, junitxml)
+class SmartTimerBench : public QObject
+{
+    Q_OBJECT
+
+private:
+    static void sizes()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("1k") << 1000;
+        QTest::newRow("10k") << 10000;
+        QTest::newRow("100k") << 100000;
+        QTest::newRow("1M") << 1000000;
+    }
+
+    static QList<int> fill(TimerManager &manager, int count)
+    {
+        QList<int> ids;
+        ids.reserve(count);
+        for (int i = 0; i < count; ++i)
+            ids.append(manager.addTimer(QString("timer-%1").arg(i), std::chrono::seconds(60 + i % 3600)));
+        return ids;
+    }
+
+private slots:
+    void add_data() { sizes(); }
+    void add()
+    {
+        QFETCH(int, count);
+        QBENCHMARK_ONCE {
+            TimerManager manager;
+            fill(manager, count);
+        }
+    }
+
+    void lookup_data() { sizes(); }
+    void lookup()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        QList<int> ids = fill(manager, count);
+
+        qint64 sum = 0;
+        QBENCHMARK {
+            for (int id : ids) sum += manager.getTimerById(id).duration().count();
+            for (int i = 0; i < 1000; ++i) sum += manager.isNameUnique(QString("timer-%1").arg(i));
+        }
+        QVERIFY(sum > 0);
+    }
+
+    void remove_data() { sizes(); }
+    void remove()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        QList<int> ids = fill(manager, count);
+
+        QBENCHMARK_ONCE {
+            manager.removeTimers(ids);
+        }
+        QCOMPARE(manager.count(), 0);
+    }
+
+    void startPause_data() { sizes(); }
+    void startPause()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        QList<int> ids = fill(manager, count);
+
+        QBENCHMARK {
+            manager.startTimers(ids);
+            manager.pauseTimers(ids);
+        }
+    }
+
+    // Просування колеса до кінця: кожен вузол каскадується і спрацьовує рівно один раз
+    void wheelExpiry_data() { sizes(); }
+    void wheelExpiry()
+    {
+        QFETCH(int, count);
+        QVector<int> expired;
+        expired.reserve(count);
+
+        QBENCHMARK {
+            TimingWheel wheel(0);
+            for (int i = 0; i < count; ++i)
+                wheel.schedule(TimingWheel::Tick(1 + (quint64(i) * 7919) % 3600000), i);
+            expired.clear();
+            for (TimingWheel::Tick t = 0; t <= 3600000; t += 1000)
+                wheel.advance(t, expired);
+        }
+        QCOMPARE(expired.size(), count);
+    }
+
+    // Аналог колишнього refreshTable: оновлення клітинок часу всіх запущених таймерів
+    void modelRefresh_data() { sizes(); }
+    void modelRefresh()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        TimerTableModel model(&manager);
+        QList<int> ids = fill(manager, count);
+        manager.startTimers(ids);
+        QMetaObject::invokeMethod(&manager, "flushUpdates");
+
+        QBENCHMARK {
+            model.refreshRunning();
+        }
+    }
+
+    // Зведене оновлення моделі після пакетної зміни стану всіх таймерів
+    void modelBatchUpdate_data() { sizes(); }
+    void modelBatchUpdate()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        TimerTableModel model(&manager);
+        QList<int> ids = fill(manager, count);
+
+        QBENCHMARK {
+            manager.startTimers(ids);
+            manager.pauseTimers(ids);
+            QMetaObject::invokeMethod(&manager, "flushUpdates");
+        }
+    }
+
+    // Доба повторюваних таймерів на симульованому годиннику: кожен повтор має спрацювати рівно раз
+    void simulatedDay_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("1k") << 1000;
+        QTest::newRow("10k") << 10000;
+    }
+    void simulatedDay()
+    {
+        QFETCH(int, count);
+        QBENCHMARK_ONCE {
+            SimulatedClock clock;
+            TimerManager manager;
+            manager.setClock(&clock);
+            QList<int> ids = fill(manager, count);
+            qint64 expected = 0;
+            for (int i = 0; i < count; ++i) {
+                manager.setSchedule(ids[i], TimerSchedule::repeat());
+                expected += 86400 / (60 + i % 3600);
+            }
+
+            qint64 finished = 0;
+            connect(&manager, &TimerManager::timerFinished, &manager, [&finished]() { ++finished; });
+            manager.startTimers(ids);
+            clock.advance(std::chrono::hours(24));
+            QCOMPARE(finished, expected);
+        }
+    }
+
+    // Публікація знімка після зміни 1000 таймерів: вартість залежить від кількості змін, а не таймерів
+    void snapshotPublish_data() { sizes(); }
+    void snapshotPublish()
+    {
+        QFETCH(int, count);
+        TimerManager manager;
+        QList<int> ids = fill(manager, count);
+        TimerSnapshot before = manager.snapshot();
+        QList<int> some = ids.mid(0, 1000);
+
+        QBENCHMARK {
+            manager.startTimers(some);
+            TimerSnapshot started = manager.snapshot();
+            manager.pauseTimers(some);
+            TimerSnapshot paused = manager.snapshot();
+            QVERIFY(started.find(some.first())->running && !paused.find(some.first())->running);
+        }
+        QVERIFY(!before.find(some.first())->running);
+    }
+
+    // Пробудження драйверів за годину на симульованому годиннику: без об'єднання і з кроком 1 с
+    void coalescedWakeups_data()
+    {
+        QTest::addColumn<int>("slack");
+        QTest::newRow("precise") << 0;
+        QTest::newRow("slack-1s") << 1000;
+    }
+    void coalescedWakeups()
+    {
+        QFETCH(int, slack);
+        const int count = 10000;
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+        manager.setWakeupSlack(slack);
+        QList<int> ids;
+        for (int i = 0; i < count; ++i)
+            ids.append(manager.addTimer(QString("timer-%1").arg(i),
+                                        std::chrono::milliseconds(1 + (qint64(i) * 7919) % 3600000)));
+
+        int finished = 0;
+        connect(&manager, &TimerManager::timerFinished, &manager, [&finished]() { ++finished; });
+        manager.startTimers(ids);
+        quint64 before = clock.firedCount();
+        clock.advance(std::chrono::hours(1) + std::chrono::seconds(1));
+        QCOMPARE(finished, count);
+        QTest::setBenchmarkResult(qreal(clock.firedCount() - before), QTest::Events);
+    }
+
+    // Байти на таймер за оцінкою менеджера, у звичайному і компактному режимах: запущені таймери
+    // з побудованим порядком спрацювання. Розбивка за частинами — у виводі
+    void memoryPerTimer_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::addColumn<bool>("compact");
+        for (int count : {1000, 100000, 1000000}) {
+            QTest::addRow("%d", count) << count << false;
+            QTest::addRow("%d-compact", count) << count << true;
+        }
+    }
+    void memoryPerTimer()
+    {
+        QFETCH(int, count);
+        QFETCH(bool, compact);
+        TimerManager manager;
+        manager.setCompactMode(compact);
+        manager.startTimers(fill(manager, count));
+        manager.nextToExpire(1);
+        TimerManager::MemoryUsage usage = manager.memoryUsage();
+        qInfo("storage %.1f, indexes %.1f, scheduling %.1f B/timer", double(usage.storage) / count,
+              double(usage.indexes) / count, double(usage.scheduling) / count);
+        QTest::setBenchmarkResult(usage.bytesPerTimer(), QTest::BytesAllocated);
+    }
+
+    // Експорт усіх таймерів у CSV і імпорт файлу в порожній менеджер одним пакетом
+    void importCsv_data() { sizes(); }
+    void importCsv()
+    {
+        QFETCH(int, count);
+        QTemporaryDir dir;
+        QString path = dir.filePath("timers.csv");
+        {
+            TimerManager manager;
+            fill(manager, count);
+            QVERIFY(TimerTransfer::exportFile(&manager, path, TimerTransfer::Csv));
+        }
+
+        QBENCHMARK_ONCE {
+            TimerManager manager;
+            TimerTransfer::ImportResult result = TimerTransfer::importFile(&manager, path, TimerTransfer::Csv);
+            QCOMPARE(result.added, count);
+            QCOMPARE(result.rejected, 0);
+        }
+    }
+
+    // Час роботи по днях за останній місяць з історії за рік: читаються лише блоки цього місяця
+    void historyRunTime_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("100k") << 100000;
+        QTest::newRow("1M") << 1000000;
+    }
+    void historyRunTime()
+    {
+        QFETCH(int, count);
+        QTemporaryDir dir;
+        SimulatedClock clock;
+        TimerHistory history(dir.path());
+        history.setClock(&clock);
+
+        // count подій рівномірно за рік: пари старт/пауза по 1000 таймерах
+        const qint64 step = 365LL * 24 * 3600 * 1000 / count;
+        for (int i = 0; i < count / 2; ++i) {
+            int id = 1 + i % 1000;
+            history.record(TimerHistory::Start, id);
+            clock.advance(TimerDuration(step));
+            history.record(TimerHistory::Pause, id);
+            clock.advance(TimerDuration(step));
+        }
+        history.flush();
+
+        qint64 to = clock.wallMs();
+        qint64 from = to - 30LL * 24 * 3600 * 1000;
+        TimerHistory::Aggregate result;
+        QBENCHMARK {
+            result = history.runTime(from, to, TimerHistory::Day);
+        }
+        qint64 total = 0;
+        for (qint64 v : result.total) total += v;
+        QVERIFY(total > 0);
+        QVERIFY(result.scannedEvents < count / 4);
+    }
+
+    void storeLoad_data() { sizes(); }
+    void storeLoad()
+    {
+        QFETCH(int, count);
+        QTemporaryDir dir;
+        {
+            TimerManager manager;
+            TimerStore store(dir.path());
+            store.load(&manager);
+            QList<int> ids = fill(manager, count);
+            manager.startTimers(ids.mid(0, count / 10));
+            store.compact();
+        }
+
+        QBENCHMARK_ONCE {
+            TimerManager manager;
+            TimerStore store(dir.path());
+            store.load(&manager);
+            QCOMPARE(manager.count(), count);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(SmartTimerBench)
+
+#include "SmartTimerBench.moc"
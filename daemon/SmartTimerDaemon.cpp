@@ -0,0 +1,63 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QTextStream>
+#include "TimerManager.h"
+#include "TimerServer.h"
+#include "TimerStore.h"
+#include "TimerHistory.h"
+
+// Фоновий режим без віджетів: таймери, сховище і сервер керування через локальний сокет.
+// SmartTimerDaemon [--socket назва] [--data каталог] [--engine-thread] [--compact]
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("SmartTimerApp");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("SmartTimer daemon");
+    parser.addHelpOption();
+    QCommandLineOption socketOption("socket", "Назва локального сокета.", "name", TimerServer::defaultName());
+    QCommandLineOption dataOption("data", "Каталог сховища таймерів.", "dir", TimerStore::defaultDirectory());
+    QCommandLineOption engineOption("engine-thread", "Планування в окремому потоці.");
+    QCommandLineOption compactOption("compact", "Компактне сховище таймерів (назви в арені).");
+    parser.addOption(socketOption);
+    parser.addOption(dataOption);
+    parser.addOption(engineOption);
+    parser.addOption(compactOption);
+    parser.process(app);
+
+    TimerManager manager;
+    if (parser.isSet(engineOption)) manager.setEngineThreadEnabled(true);
+    if (parser.isSet(compactOption)) manager.setCompactMode(true);
+
+    TimerStore store(parser.value(dataOption));
+    store.load(&manager);
+    manager.attachStore(&store);
+
+    // Історія запусків — поруч зі сховищем
+    TimerHistory history(QDir(parser.value(dataOption)).filePath("history"));
+    manager.attachHistory(&history);
+
+    TimerServer server(&manager);
+    if (!server.listen(parser.value(socketOption))) {
+        QTextStream(stderr) << "Не вдалося відкрити сокет: " << server.errorString() << '\n';
+        return 1;
+    }
+    QTextStream(stdout) << "Слухаю " << server.serverName() << '\n';
+
+    // Вікна немає: звук і сповіщення дій лише пишуться у вивід
+    ActionDispatcher &actions = manager.actionDispatcher();
+    QObject::connect(&actions, &ActionDispatcher::notificationRequested, &app,
+                     [](int id, const QString &name, const QString &text) {
+                         QTextStream(stdout) << "Таймер " << id << " (" << name << "): " << text << Qt::endl;
+                     });
+    QObject::connect(&actions, &ActionDispatcher::soundRequested, &app,
+                     [](int id) { QTextStream(stdout) << "Таймер " << id << ": звук" << Qt::endl; });
+    QObject::connect(&actions, &ActionDispatcher::actionFailed, &app,
+                     [](int id, const QString &action, const QString &error) {
+                         QTextStream(stderr) << "Таймер " << id << ", дія \"" << action << "\": " << error << Qt::endl;
+                     });
+
+    return app.exec();
+}
@@ -3,11 +3,17 @@
 #include <QHBoxLayout>
 #include <QHeaderView>
 #include <QMessageBox>
-#include <QCheckBox>
+#include <QApplication>
+#include <QStatusBar>
+#include <QWindow>
+#include <QFileDialog>
 #include "AddTimerDialog.h"
+#include "TimerServer.h"
+#include "TimerTransfer.h"
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), manager(new TimerManager(this))
+    : QMainWindow(parent), manager(new TimerManager(this)), store(nullptr), history(nullptr),
+      statsDialog(nullptr), groupsDialog(nullptr), historyDialog(nullptr), remote(nullptr), mirror(nullptr)
 {
     resize(750, 450);
 
@@ -16,13 +22,58 @@ MainWindow::MainWindow(QWidget *parent)
 
     QVBoxLayout *mainLayout = new QVBoxLayout(central);
 
-    // Таблиця
-    timerTable = new QTableWidget();
-    timerTable->setColumnCount(6);
-    timerTable->setHorizontalHeaderLabels({"№", "Виділити", "Назва", "Час", "Статус", "Дії"});
+    // --attach [сокет]: вікно стає ще одним клієнтом SmartTimerDaemon замість власних таймерів
+    const QStringList arguments = QCoreApplication::arguments();
+    int attachArg = arguments.indexOf("--attach");
+    if (attachArg >= 0) {
+        QString name = attachArg + 1 < arguments.size() && !arguments.at(attachArg + 1).startsWith("--")
+                           ? arguments.at(attachArg + 1) : TimerServer::defaultName();
+        if (!attachToServer(name))
+            QMessageBox::warning(this, "Помилка", QString("Не вдалося під'єднатися до %1, працюю локально").arg(name));
+    }
+
+    if (!remote) {
+        // --engine-thread: таймери плануються в окремому потоці, незалежно від навантаження GUI
+        if (arguments.contains("--engine-thread"))
+            manager->setEngineThreadEnabled(true);
+
+        // --compact: компактне сховище для дуже великої кількості таймерів
+        if (arguments.contains("--compact"))
+            manager->setCompactMode(true);
+
+        // Відновлюємо збережені таймери до того, як до менеджера підключиться модель
+        store = new TimerStore(TimerStore::defaultDirectory(), this);
+        store->load(manager);
+        manager->attachStore(store);
+        history = new TimerHistory(TimerHistory::defaultDirectory(), this);
+        manager->attachHistory(history);
+    }
+
+    // Таблиця: модель над менеджером, кнопки дій, час і статус малюють делегати
+    model = new TimerTableModel(manager, this);
+    actionsDelegate = new TimerActionsDelegate(this);
+    cellDelegate = new TimerCellDelegate(this);
+
+    // Пошук за назвою над таблицею; фільтрує індекс менеджера, а не рядки таблиці
+    searchEdit = new QLineEdit();
+    searchEdit->setPlaceholderText("Пошук за назвою…");
+    searchEdit->setClearButtonEnabled(true);
+    soonestCheck = new QCheckBox("Спочатку найближчі");
+
+    QHBoxLayout *searchLayout = new QHBoxLayout();
+    searchLayout->addWidget(searchEdit);
+    searchLayout->addWidget(soonestCheck);
+    mainLayout->addLayout(searchLayout);
+
+    timerTable = new QTableView();
+    timerTable->setModel(model);
+    timerTable->setItemDelegateForColumn(TimerTableModel::ActionsColumn, actionsDelegate);
+    timerTable->setItemDelegateForColumn(TimerTableModel::TimeColumn, cellDelegate);
+    timerTable->setItemDelegateForColumn(TimerTableModel::StatusColumn, cellDelegate);
     timerTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     timerTable->verticalHeader()->setVisible(false);
     timerTable->setEditTriggers(QAbstractItemView::NoEditTriggers); // вимикаємо редагування
+    timerTable->viewport()->installEventFilter(this);  // вимір затримки від сигналу до перемальовування
     mainLayout->addWidget(timerTable);
 
     // Кнопки знизу
@@ -31,14 +82,29 @@ MainWindow::MainWindow(QWidget *parent)
     startButton = new QPushButton("Старт обрані");
     stopButton = new QPushButton("Стоп обрані");
     deleteButton = new QPushButton("Видалити обрані");
+    resetButton = new QPushButton("Скинути обрані");
     editButton = new QPushButton("Редагувати");
     editButton->setEnabled(false);
+    statsButton = new QPushButton("Статистика");
+    groupsButton = new QPushButton("Групи");
+    groupsButton->setEnabled(!remote);    // групи протоколом керування не передаються
+    historyButton = new QPushButton("Історія");
+    historyButton->setEnabled(!remote);   // історію веде процес, що володіє таймерами
+    importButton = new QPushButton("Імпорт");
+    exportButton = new QPushButton("Експорт");
 
     btnLayout->addWidget(addButton);
     btnLayout->addWidget(startButton);
     btnLayout->addWidget(stopButton);
     btnLayout->addWidget(deleteButton);
+    btnLayout->addWidget(resetButton);
     btnLayout->addWidget(editButton);
+    btnLayout->addStretch();
+    btnLayout->addWidget(importButton);
+    btnLayout->addWidget(exportButton);
+    btnLayout->addWidget(groupsButton);
+    btnLayout->addWidget(historyButton);
+    btnLayout->addWidget(statsButton);
     mainLayout->addLayout(btnLayout);
 
     // Підключення кнопок
@@ -46,196 +112,360 @@ MainWindow::MainWindow(QWidget *parent)
     connect(startButton, &QPushButton::clicked, this, &MainWindow::onStartSelected);
     connect(stopButton, &QPushButton::clicked, this, &MainWindow::onStopSelected);
     connect(deleteButton, &QPushButton::clicked, this, &MainWindow::onDeleteSelected);
+    connect(resetButton, &QPushButton::clicked, this, &MainWindow::onResetSelected);
     connect(editButton, &QPushButton::clicked, this, &MainWindow::onEditSelected);
+    connect(statsButton, &QPushButton::clicked, this, &MainWindow::onShowStats);
+    connect(groupsButton, &QPushButton::clicked, this, &MainWindow::onShowGroups);
+    connect(historyButton, &QPushButton::clicked, this, &MainWindow::onShowHistory);
+    connect(importButton, &QPushButton::clicked, this, &MainWindow::onImport);
+    connect(exportButton, &QPushButton::clicked, this, &MainWindow::onExport);
+
+    // Дії в рядку; видалення відкладаємо, щоб не прибирати рядок посеред обробки кліку
+    connect(actionsDelegate, &TimerActionsDelegate::toggleClicked, this, &MainWindow::onToggleTimer);
+    connect(actionsDelegate, &TimerActionsDelegate::deleteClicked, manager,
+            [this](int id) { applyToTimers(Ipc::CmdRemove, {id}); }, Qt::QueuedConnection);
+    connect(model, &TimerTableModel::checkedCountChanged, this, &MainWindow::updateEditButtonVisibility);
+    connect(searchEdit, &QLineEdit::textChanged, model, &TimerTableModel::setFilter);
+    connect(soonestCheck, &QCheckBox::toggled, model, [this](bool on) {
+        model->setRowOrder(on ? TimerTableModel::SoonestFirst : TimerTableModel::InsertionOrder);
+    });
 
     // Сигнали від менеджера
-    connect(manager, &TimerManager::timerUpdated, this, &MainWindow::refreshTable);
-    connect(manager, &TimerManager::timerFinished, this, &MainWindow::refreshTable);
+    connect(manager, &TimerManager::timersUpdated, this, &MainWindow::updateDisplayTimer);
+
+    // Дії при спрацюванні виконуються в пулі потоків; вікну лишаються звук і сповіщення.
+    // Файл звуку без Qt Multimedia не відтворюється — лише системний сигнал
+    ActionDispatcher &actions = manager->actionDispatcher();
+    connect(&actions, &ActionDispatcher::soundRequested, this, []() { QApplication::beep(); });
+    connect(&actions, &ActionDispatcher::notificationRequested, this, [this](int, const QString &name, const QString &text) {
+        statusBar()->showMessage(QString("%1: %2").arg(name, text), 10000);
+        QApplication::alert(this);
+    });
+    connect(&actions, &ActionDispatcher::actionFailed, this, [this](int id, const QString &action, const QString &error) {
+        statusBar()->showMessage(QString("Таймер %1, дія \"%2\": %3").arg(id).arg(action, error), 10000);
+    });
 
-    refreshTable();
+    // Менеджер не шле сигналів щосекунди — відлік на екрані оновлюємо самі
+    displayTimer = new QTimer(this);
+    displayTimer->setTimerType(Qt::PreciseTimer);
+    displayTimer->setInterval(1000);
+    connect(displayTimer, &QTimer::timeout, model, &TimerTableModel::refreshRunning);
+    connect(displayTimer, &QTimer::timeout, this, &MainWindow::updateDisplayTimer);
+    updateDisplayTimer();
+
+    // --stats-json <файл>: статистика скидається у JSON щохвилини і при виході
+    int statsArg = arguments.indexOf("--stats-json");
+    if (statsArg >= 0 && statsArg + 1 < arguments.size()) {
+        statsDumpPath = arguments.at(statsArg + 1);
+        QTimer *dumpTimer = new QTimer(this);
+        dumpTimer->setInterval(60 * 1000);
+        connect(dumpTimer, &QTimer::timeout, this, &MainWindow::dumpStats);
+        dumpTimer->start();
+    }
 }
 
 MainWindow::~MainWindow()
 {
+    if (store) store->flush();
+    if (history) history->flush();
+    dumpStats();
+    delete model;
     delete manager;
 }
 
-QString MainWindow::formatTime(int totalSeconds) const
+void MainWindow::updateEditButtonVisibility()
 {
-    int h = totalSeconds / 3600;
-    int m = (totalSeconds % 3600) / 60;
-    int s = totalSeconds % 60;
-    return QString("%1:%2:%3")
-        .arg(h, 2, 10, QChar('0'))
-        .arg(m, 2, 10, QChar('0'))
-        .arg(s, 2, 10, QChar('0'));
+    editButton->setEnabled(model->checkedCount() == 1);
 }
 
-void MainWindow::refreshTable()
+void MainWindow::updateDisplayTimer()
 {
-    // Зберігаємо стан виділення
-    QMap<int, bool> selectedMap;
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1));
-        if (check) selectedMap[row] = check->isChecked();
-    }
-
-    QList<TimerEntry*> timers = manager->getAllTimersPointers();
-    timerTable->setRowCount(timers.size());
-
-    for (int i = 0; i < timers.size(); ++i) {
-        TimerEntry* t = timers[i];
-
-        // № рядка
-        timerTable->setItem(i, 0, new QTableWidgetItem(QString::number(i + 1)));
-
-        // Чекбокс
-        QCheckBox *check = new QCheckBox();
-        check->setProperty("timerId", t->id);
-
-        // Відновлюємо стан чекбокса
-        if (selectedMap.contains(i)) check->setChecked(selectedMap[i]);
-
-        timerTable->setCellWidget(i, 1, check);
-        connect(check, &QCheckBox::stateChanged, this, &MainWindow::updateEditButtonVisibility);
-
-        // Назва
-        timerTable->setItem(i, 2, new QTableWidgetItem(t->name));
-
-        // Час
-        timerTable->setItem(i, 3, new QTableWidgetItem(formatTime(t->remainingSeconds)));
-
-        // Статус
-        timerTable->setItem(i, 4, new QTableWidgetItem(t->running ? "Біжить" : "Пауза"));
-
-        // Дії: Старт/Стоп + Видалити
-        QWidget *actionWidget = new QWidget();
-        QHBoxLayout *actionLayout = new QHBoxLayout(actionWidget);
-        actionLayout->setContentsMargins(2, 2, 2, 2);
-
-        QPushButton *toggleBtn = new QPushButton("Старт/Стоп");
-        QPushButton *deleteBtn = new QPushButton("Видалити");
-
-        actionLayout->addWidget(toggleBtn);
-        actionLayout->addWidget(deleteBtn);
-        timerTable->setCellWidget(i, 5, actionWidget);
-
-        connect(toggleBtn, &QPushButton::clicked, this, [=]() {
-            if (t->running) manager->pauseTimer(t->id);
-            else manager->startTimer(t->id);
-            refreshTable();
-        });
-
-        connect(deleteBtn, &QPushButton::clicked, this, [=]() {
-            manager->removeTimer(t->id);
-            refreshTable();
-        });
+    if (!idle && manager->runningCount() > 0) {
+        // Останні секунди відліку (і мілісекундні таймери) оновлюємо частіше
+        qint64 next = manager->storage().nextDeadline();
+        int interval = next >= 0 && next - manager->storage().nowMs() < 10000 ? 100 : 1000;
+        if (displayTimer->interval() != interval) displayTimer->setInterval(interval);
+        if (!displayTimer->isActive()) displayTimer->start();
+    } else {
+        displayTimer->stop();
     }
-
-    updateEditButtonVisibility();
 }
 
-void MainWindow::updateEditButtonVisibility()
+void MainWindow::onToggleTimer(int id)
 {
-    int selectedCount = 0;
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1)); // колонка 1 = чекбокс
-        if (check && check->isChecked()) selectedCount++;
-    }
-    editButton->setEnabled(selectedCount == 1);
+    TimerView t = manager->getTimerById(id);
+    if (!t) return;
+
+    applyToTimers(t.running() ? Ipc::CmdPause : Ipc::CmdStart, {id});
 }
 
 void MainWindow::onAddTimer()
 {
     AddTimerDialog dlg(this);
-    connect(&dlg, &AddTimerDialog::timerCreated, this, [=](const QString &name, int durationSeconds){
+    connect(&dlg, &AddTimerDialog::timerCreated, this, [=](const QString &name, TimerDuration duration, const TimerSchedule &schedule){
         if (!manager->isNameUnique(name)) {
             QMessageBox::warning(this, "Помилка", "Назва має бути унікальною");
             return;
         }
-        manager->addTimer(name, durationSeconds);
-        refreshTable();
+        if (remote) {
+            TimerClient::Batch batch;
+            batch.add(name, duration, schedule);
+            remote->send(batch);
+        } else {
+            manager->addTimer(name, duration, schedule);
+        }
     });
     dlg.exec();
 }
 
 void MainWindow::onStartSelected()
 {
-    QList<TimerEntry*> timers = manager->getAllTimersPointers();
-    QVector<int> selectedIds;
-
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1));
-        if (check && check->isChecked()) selectedIds.append(timers[row]->id);
-    }
-
-    for (int id : selectedIds) manager->startTimer(id);
+    applyToTimers(Ipc::CmdStart, model->checkedIds());
 
     // Скидаємо чекбокси
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1));
-        if (check) check->setChecked(false);
-    }
-
-    refreshTable();
+    model->clearChecked();
 }
 
 
 void MainWindow::onStopSelected()
 {
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1)); // колонка з чекбоксом
-        if (check && check->isChecked()) {
-            int id = check->property("timerId").toInt();
-            manager->pauseTimer(id);
+    applyToTimers(Ipc::CmdPause, model->checkedIds());
 
-            // Скидаємо виділення лише для тих, що зупинили
-            check->setChecked(false);
-        }
-    }
-    refreshTable();
+    // Скидаємо виділення
+    model->clearChecked();
 }
 
 
 void MainWindow::onDeleteSelected()
 {
-    for (int row = timerTable->rowCount() - 1; row >= 0; --row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1));
-        if (check && check->isChecked()) {
-            int id = check->property("timerId").toInt();
-            manager->removeTimer(id);
-        }
-    }
-    refreshTable();
+    applyToTimers(Ipc::CmdRemove, model->checkedIds());
+}
+
+void MainWindow::onResetSelected()
+{
+    applyToTimers(Ipc::CmdReset, model->checkedIds());
+    model->clearChecked();
 }
 
 void MainWindow::onEditSelected()
 {
-    int editId = -1;
-    for (int row = 0; row < timerTable->rowCount(); ++row) {
-        QCheckBox *check = qobject_cast<QCheckBox*>(timerTable->cellWidget(row, 1));
-        if (check && check->isChecked()) {
-            editId = check->property("timerId").toInt();
-            break;
-        }
-    }
-    if (editId == -1) return;
+    QList<int> ids = model->checkedIds();
+    if (ids.size() != 1) return;
+    int editId = ids.first();
 
-    TimerEntry* entry = manager->getTimerById(editId);
+    TimerView entry = manager->getTimerById(editId);
     if (!entry) return;
 
     EditTimerDialog dlg(this);
     dlg.setTimerData(entry);
+    dlg.setActionsEnabled(!remote);     // дії протоколом керування не передаються
 
-    connect(&dlg, &EditTimerDialog::timerEdited, this, [=](const QString&, const QString &newName, qint64 duration){
+    connect(&dlg, &EditTimerDialog::timerEdited, this, [=](const QString&, const QString &newName, TimerDuration duration,
+                                                           const TimerSchedule &schedule, const QVector<TimerAction> &actions){
         if (!manager->isNameUnique(newName, editId)) {
             QMessageBox::warning(this, "Помилка", "Назва має бути унікальною");
             return;
         }
-        manager->updateTimer(editId, newName, duration);
-        refreshTable();
+        // Таймер, що переходить на розклад cron, може мати нульову тривалість — тож розклад ставиться першим
+        bool calendar = schedule.kind == TimerSchedule::Calendar;
+        if (remote) {
+            TimerClient::Batch batch;
+            if (calendar) batch.setSchedule(editId, schedule);
+            batch.update(editId, newName, duration);
+            if (!calendar) batch.setSchedule(editId, schedule);
+            remote->send(batch);
+        } else {
+            if (calendar) manager->setSchedule(editId, schedule);
+            manager->updateTimer(editId, newName, duration);
+            if (!calendar) manager->setSchedule(editId, schedule);
+            manager->setActions(editId, actions);
+        }
     });
 
     dlg.exec();
-    refreshTable();
+}
+
+bool MainWindow::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::Paint && watched == timerTable->viewport())
+        manager->stats().markPainted();
+    // Перекриття іншими вікнами платформа повідомляє лише подіями Expose нативного вікна
+    if (event->type() == QEvent::Expose && watched == windowHandle())
+        updateIdleState();
+    return QMainWindow::eventFilter(watched, event);
+}
+
+void MainWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+    if (QWindow *window = windowHandle()) {
+        window->removeEventFilter(this);
+        window->installEventFilter(this);
+    }
+    updateIdleState();
+}
+
+void MainWindow::hideEvent(QHideEvent *event)
+{
+    QMainWindow::hideEvent(event);
+    updateIdleState();
+}
+
+void MainWindow::changeEvent(QEvent *event)
+{
+    QMainWindow::changeEvent(event);
+    if (event->type() == QEvent::WindowStateChange) updateIdleState();
+}
+
+void MainWindow::updateIdleState()
+{
+    bool nowIdle = !isVisible() || isMinimized() || (windowHandle() && !windowHandle()->isExposed());
+    if (nowIdle == idle) return;
+    idle = nowIdle;
+
+    // Після повернення одне зведене оновлення таблиці наздоганяє все, що змінилось за цей час
+    model->setSuspended(idle);
+    manager->setWakeupSlack(idle ? IdleWakeupSlackMs : 0);
+    updateDisplayTimer();
+}
+
+void MainWindow::onShowStats()
+{
+    if (!statsDialog) statsDialog = new StatsDialog(manager, this);
+    statsDialog->show();
+    statsDialog->raise();
+    statsDialog->activateWindow();
+}
+
+void MainWindow::onShowGroups()
+{
+    if (!groupsDialog) groupsDialog = new GroupsDialog(manager, model, this);
+    groupsDialog->show();
+    groupsDialog->raise();
+    groupsDialog->activateWindow();
+}
+
+void MainWindow::onShowHistory()
+{
+    if (!history) return;
+    if (!historyDialog) historyDialog = new HistoryDialog(history, this);
+    else historyDialog->refresh();
+    historyDialog->show();
+    historyDialog->raise();
+    historyDialog->activateWindow();
+}
+
+void MainWindow::onImport()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Імпорт таймерів", QString(),
+                                                "Таймери (*.csv *.jsonl *.ndjson *.json);;Усі файли (*)");
+    if (path.isEmpty()) return;
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    TimerTransfer::Format format = TimerTransfer::formatOf(path);
+    TimerTransfer::ImportResult result;
+    if (remote) {
+        // Унікальність назв перевіряє сервер; пачки обмежені, щоб не тримати один величезний кадр
+        TimerTransfer::ParseResult parsed = TimerTransfer::parseFile(path, format, [this](const TimerTransfer::Chunk &chunk) {
+            const int BatchSize = 1000;
+            for (int i = 0; i < chunk.timers.size(); i += BatchSize) {
+                TimerClient::Batch batch;
+                for (int j = i; j < qMin(i + BatchSize, int(chunk.timers.size())); ++j)
+                    batch.add(chunk.timers[j].name, chunk.timers[j].duration, chunk.timers[j].schedule);
+                remote->send(batch);
+            }
+        });
+        result.error = parsed.error;
+        result.errors = parsed.errors;
+        result.rejected = parsed.invalid;
+        result.added = parsed.parsed;
+    } else {
+        result = TimerTransfer::importFile(manager, path, format);
+    }
+    QApplication::restoreOverrideCursor();
+
+    if (!result.error.isEmpty()) {
+        QMessageBox::warning(this, "Помилка", QString("Не вдалося прочитати %1: %2").arg(path, result.error));
+        return;
+    }
+    QString summary = QString(remote ? "Надіслано таймерів: %1" : "Додано таймерів: %1").arg(result.added);
+    if (result.rejected == 0) {
+        statusBar()->showMessage(summary, 10000);
+        return;
+    }
+
+    QMessageBox box(QMessageBox::Warning, "Імпорт", QString("%1\nВідхилено рядків: %2").arg(summary).arg(result.rejected),
+                    QMessageBox::Ok, this);
+    box.setDetailedText(result.errors.join('\n'));
+    box.exec();
+}
+
+void MainWindow::onExport()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Експорт таймерів", "timers.csv",
+                                                "CSV (*.csv);;JSON Lines (*.jsonl)");
+    if (path.isEmpty()) return;
+
+    // У режимі --attach менеджер — копія таймерів сервера, тож експортується її стан
+    QString error;
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    bool ok = TimerTransfer::exportFile(manager, path, TimerTransfer::formatOf(path), &error);
+    QApplication::restoreOverrideCursor();
+    if (ok) statusBar()->showMessage(QString("Експортовано в %1").arg(path), 10000);
+    else QMessageBox::warning(this, "Помилка", QString("Не вдалося записати %1: %2").arg(path, error));
+}
+
+void MainWindow::dumpStats()
+{
+    if (!statsDumpPath.isEmpty()) manager->stats().dumpToFile(statsDumpPath);
+}
+
+bool MainWindow::attachToServer(const QString &name)
+{
+    remote = new TimerClient(this);
+    mirror = new TimerMirror(remote, manager, this);
+    if (remote->connectToServer(name) && mirror->attach()) {
+        connect(remote, &TimerClient::disconnected, this, &MainWindow::onRemoteDisconnected);
+        setWindowTitle(QString("SmartTimer — %1").arg(name));
+        return true;
+    }
+
+    delete mirror;
+    delete remote;
+    mirror = nullptr;
+    remote = nullptr;
+    return false;
+}
+
+void MainWindow::onRemoteDisconnected()
+{
+    QMessageBox::warning(this, "Помилка", "З'єднання з сервером таймерів втрачено");
+    setEnabled(false);
+}
+
+// У режимі --attach команди йдуть на сервер, а локальна копія оновиться з потоку подій
+void MainWindow::applyToTimers(Ipc::Command cmd, const QList<int> &ids)
+{
+    if (remote) {
+        TimerClient::Batch batch;
+        for (int id : ids) {
+            switch (cmd) {
+            case Ipc::CmdStart: batch.start(id); break;
+            case Ipc::CmdPause: batch.pause(id); break;
+            case Ipc::CmdRemove: batch.remove(id); break;
+            case Ipc::CmdReset: batch.reset(id); break;
+            default: break;
+            }
+        }
+        remote->send(batch);
+        return;
+    }
+
+    switch (cmd) {
+    case Ipc::CmdStart: manager->startTimers(ids); break;
+    case Ipc::CmdPause: manager->pauseTimers(ids); break;
+    case Ipc::CmdRemove: manager->removeTimers(ids); break;
+    case Ipc::CmdReset: manager->resetTimers(ids); break;
+    default: break;
+    }
 }
@@ -2,11 +2,21 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
-#include <QTableWidget>
+#include <QTableView>
 #include <QPushButton>
+#include <QLineEdit>
 #include <QCheckBox>
 #include "TimerManager.h"
+#include "TimerStore.h"
+#include "TimerTableModel.h"
+#include "TimerActionsDelegate.h"
+#include "TimerCellDelegate.h"
 #include "EditTimerDialog.h"
+#include "StatsDialog.h"
+#include "GroupsDialog.h"
+#include "HistoryDialog.h"
+#include "TimerClient.h"
+#include "TimerMirror.h"
 
 class MainWindow : public QMainWindow
 {
@@ -16,27 +26,72 @@ public:
     explicit MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void changeEvent(QEvent *event) override;
+
 private slots:
     void onAddTimer();
     void onStartSelected();
     void onStopSelected();
     void onDeleteSelected();
+    void onResetSelected();
     void onEditSelected();
+    void onShowStats();
+    void onShowGroups();
+    void onShowHistory();
+    void onImport();
+    void onExport();
+    void dumpStats();
+    void onRemoteDisconnected();
 
-    void refreshTable();
+    void onToggleTimer(int id);
     void updateEditButtonVisibility();
+    void updateDisplayTimer();
 
 private:
-    QTableWidget *timerTable;
+    QTableView *timerTable;
+    QLineEdit *searchEdit;
+    QCheckBox *soonestCheck;
     QPushButton *addButton;
     QPushButton *startButton;
     QPushButton *stopButton;
     QPushButton *deleteButton;
+    QPushButton *resetButton;
     QPushButton *editButton;
+    QPushButton *statsButton;
+    QPushButton *groupsButton;
+    QPushButton *historyButton;
+    QPushButton *importButton;
+    QPushButton *exportButton;
 
     TimerManager *manager;
+    TimerStore *store;
+    TimerHistory *history;
+    TimerTableModel *model;
+    TimerActionsDelegate *actionsDelegate;
+    TimerCellDelegate *cellDelegate;
+    QTimer *displayTimer;   // оновлення відліку на екрані, поки є запущені таймери
+
+    StatsDialog *statsDialog;
+    GroupsDialog *groupsDialog;
+    HistoryDialog *historyDialog;
+
+    // Режим --attach: таблиця показує копію таймерів сервера, команди йдуть через клієнт
+    TimerClient *remote;
+    TimerMirror *mirror;
+
+    // Вікно сховане, згорнуте чи повністю перекрите: відлік на екрані зупинено,
+    // модель призупинено, а менеджер об'єднує пробудження з кроком IdleWakeupSlackMs
+    bool idle = false;
+    static constexpr int IdleWakeupSlackMs = 1000;
+    void updateIdleState();
 
-    QString formatTime(int totalSeconds) const;
+    void applyToTimers(Ipc::Command cmd, const QList<int> &ids);
+    bool attachToServer(const QString &name);
+    QString statsDumpPath;
 };
 
 #endif // MAINWINDOW_H
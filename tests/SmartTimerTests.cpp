@@ -0,0 +1,645 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include "Clock.h"
+#include "TimingWheel.h"
+#include "TimerManager.h"
+#include "TimerStore.h"
+#include "BinaryCodec.h"
+#include "TimerSchedule.h"
+#include "TimerTransfer.h"
+#include <algorithm>
+#include <map>
+#include <random>
+
+// Тести ядра: межі каскадів колеса таймерів, менеджер на симульованому годиннику, відновлення сховища,
+// розклади cron, імпорт CSV і JSON Lines
+class SmartTimerTests : public QObject
+{
+    Q_OBJECT
+
+private:
+    // Коди записів журналу TimerStore
+    enum { OpAdd = 1, OpPause = 4 };
+
+    static QStringList names(const TimerManager &manager)
+    {
+        QStringList list;
+        for (int id : manager.timerIds()) list.append(manager.getTimerById(id).name());
+        list.sort();
+        return list;
+    }
+
+    // Знімок і журнал у форматі старої версії, як їх писала та версія програми:
+    // "Чай" на паузі, "Обід" запущений на 10 хв, у журналі — додана "Прогулянка" і пауза "Чаю"
+    static void writeLegacyStore(const QString &directory, int version, qint64 savedAt)
+    {
+        using namespace BinaryCodec;
+        auto putDuration = [version](QByteArray &out, int seconds) {
+            if (version < 2) put(out, qint32(seconds));
+            else put(out, qint64(seconds) * 1000);
+        };
+        auto putTimer = [&](QByteArray &out, int id, const QString &name, int seconds, qint64 remainingMs,
+                            qint64 wallDeadlineMs, const TimerSchedule &schedule) {
+            put(out, qint32(id));
+            putDuration(out, seconds);
+            put(out, remainingMs);
+            put(out, wallDeadlineMs);
+            putString(out, name);
+            if (version >= 3) putSchedule(out, schedule);
+            if (version >= 4) put(out, qint32(0));
+            if (version >= 5) putActions(out, {});
+        };
+
+        QByteArray snap;
+        put(snap, quint32(0x535453) | (quint32('0' + version) << 24));
+        put(snap, quint32(1));
+        put(snap, quint32(2));
+        put(snap, qint32(3));
+        put(snap, savedAt);
+        putTimer(snap, 1, "Чай", 180, 120000, 0, TimerSchedule::repeat());
+        putTimer(snap, 2, "Обід", 3600, 3600000, savedAt + 600000, TimerSchedule());
+        if (version >= 4) put(snap, quint32(0));
+
+        QByteArray journal;
+        put(journal, quint32(0x4A5453) | (quint32('0' + version) << 24));
+        put(journal, quint32(1));
+        put(journal, quint8(OpAdd));
+        put(journal, qint32(3));
+        putDuration(journal, 300);
+        putString(journal, "Прогулянка");
+        put(journal, quint8(OpPause));
+        put(journal, qint32(1));
+        put(journal, qint64(60000));
+
+        QFile snapFile(QDir(directory).filePath("timers.snap"));
+        QVERIFY(snapFile.open(QIODevice::WriteOnly));
+        snapFile.write(snap);
+        QFile journalFile(QDir(directory).filePath("timers.journal"));
+        QVERIFY(journalFile.open(QIODevice::WriteOnly));
+        journalFile.write(journal);
+    }
+
+    struct Parsed {
+        TimerTransfer::ParseResult result;
+        QVector<TimerManager::NewTimer> timers;
+        QVector<int> lines;
+    };
+
+    static QString writeFile(const QTemporaryDir &dir, const QString &name, const QByteArray &content)
+    {
+        QString path = dir.filePath(name);
+        QFile file(path);
+        if (file.open(QIODevice::WriteOnly)) file.write(content);
+        return path;
+    }
+
+    static Parsed parse(const QString &path)
+    {
+        Parsed parsed;
+        parsed.result = TimerTransfer::parseFile(path, TimerTransfer::formatOf(path), [&parsed](const TimerTransfer::Chunk &chunk) {
+            parsed.timers += chunk.timers;
+            parsed.lines += chunk.lines;
+        });
+        return parsed;
+    }
+
+private slots:
+    // Переходи на літній час детерміновані: правила київського часу рядком POSIX, без бази часових поясів
+    void initTestCase()
+    {
+        qputenv("TZ", "EET-2EEST,M3.5.0/3,M10.5.0/4");
+    }
+
+    // Дедлайни біля меж рівнів колеса (64^k тіків) — звідти вузли переходять каскадом на нижчий рівень
+    void wheelCascade_data()
+    {
+        QTest::addColumn<quint64>("start");
+        QTest::addColumn<quint64>("delta");
+        for (int level = 1; level <= 6; ++level) {
+            const quint64 b = quint64(1) << (6 * level);
+            QTest::addRow("L%d-before", level) << quint64(0) << b - 1;
+            QTest::addRow("L%d-at", level) << quint64(0) << b;
+            QTest::addRow("L%d-after", level) << quint64(0) << b + 1;
+            QTest::addRow("L%d-cross", level) << b - 1 << quint64(1);
+            QTest::addRow("L%d-next-block", level) << b - 1 << b;
+            QTest::addRow("L%d-unaligned", level) << b + b / 2 + 13 << b;
+        }
+        QTest::addRow("overflow") << (quint64(1) << 40) + 5 << (quint64(1) << 36) * 3 + 7;
+    }
+
+    void wheelCascade()
+    {
+        QFETCH(quint64, start);
+        QFETCH(quint64, delta);
+        const TimingWheel::Tick expiry = start + delta;
+
+        // Одним стрибком до тіку перед дедлайном: каскади не випускають вузол раніше
+        TimingWheel wheel(start);
+        wheel.schedule(expiry, 1);
+        QVector<int> expired;
+        wheel.advance(expiry - 1, expired);
+        QVERIFY(expired.isEmpty());
+        QVERIFY(wheel.nextEventTick() <= expiry);
+        wheel.advance(expiry, expired);
+        QCOMPARE(expired, QVector<int>{1});
+        QVERIFY(wheel.isEmpty());
+    }
+
+    // Ті самі дедлайни кроками по nextEventTick(): кожен каскад — окремий крок,
+    // і вузол спрацьовує саме на своєму тіку
+    void wheelCascadeSteps_data() { wheelCascade_data(); }
+    void wheelCascadeSteps()
+    {
+        QFETCH(quint64, start);
+        QFETCH(quint64, delta);
+        const TimingWheel::Tick expiry = start + delta;
+
+        TimingWheel wheel(start);
+        wheel.schedule(expiry, 1);
+        QVector<int> expired;
+        int steps = 0;
+        while (expired.isEmpty()) {
+            TimingWheel::Tick next = wheel.nextEventTick();
+            QVERIFY(next > wheel.currentTick());
+            QVERIFY(next <= expiry);
+            wheel.advance(next, expired);
+            QVERIFY(++steps <= 16);
+        }
+        QCOMPARE(wheel.currentTick(), expiry);
+    }
+
+    // Порівняння з упорядкованою мапою на випадкових дедлайнах і стрибках часу
+    void wheelRandomized()
+    {
+        std::mt19937_64 rng(7);
+        TimingWheel wheel(1000);
+        std::multimap<quint64, int> reference;
+        quint64 now = 1000;
+        for (int i = 0; i < 20000; ++i) {
+            quint64 expiry = now + 1 + (i % 5 == 0 ? rng() % (quint64(1) << 30) : rng() % 5000);
+            wheel.schedule(expiry, i);
+            reference.insert({expiry, i});
+            if (i % 10 != 0) continue;
+
+            now += i % 100 == 0 ? rng() % (quint64(1) << 26) : rng() % 200;
+            QVector<int> expired;
+            wheel.advance(now, expired);
+            QVector<int> expected;
+            while (!reference.empty() && reference.begin()->first <= now) {
+                expected.append(reference.begin()->second);
+                reference.erase(reference.begin());
+            }
+            std::sort(expired.begin(), expired.end());
+            std::sort(expected.begin(), expected.end());
+            QCOMPARE(expired, expected);
+            QCOMPARE(wheel.size(), int(reference.size()));
+        }
+    }
+
+    // Обрізаний або зіпсований хвіст журналу відкидається й обрізається у файлі,
+    // і нові записи після нього читаються наступним запуском
+    void storeTruncatedJournal_data()
+    {
+        QTest::addColumn<int>("cut");
+        QTest::addColumn<QByteArray>("tail");
+        QTest::addColumn<int>("survived");
+        QTest::newRow("mid-record") << 3 << QByteArray() << 2;
+        QTest::newRow("op-only") << 16 << QByteArray() << 2;
+        QTest::newRow("unknown-op") << 0 << QByteArray("\xEE\x01\x00\x00\x00", 5) << 3;
+    }
+
+    void storeTruncatedJournal()
+    {
+        QFETCH(int, cut);
+        QFETCH(QByteArray, tail);
+        QFETCH(int, survived);
+
+        QTemporaryDir dir;
+        const QString journalPath = QDir(dir.path()).filePath("timers.journal");
+        qint64 intact, full;
+        {
+            TimerManager manager;
+            TimerStore store(dir.path());
+            QVERIFY(store.load(&manager));
+            manager.attachStore(&store);
+            manager.addTimer("a", std::chrono::seconds(10));
+            manager.addTimer("b", std::chrono::seconds(20));
+            store.flush();
+            intact = QFileInfo(journalPath).size();
+            manager.addTimer("c", std::chrono::seconds(30));
+            store.flush();
+            full = QFileInfo(journalPath).size();
+        }
+
+        // Аварійне завершення посеред запису
+        QVERIFY(QFile::resize(journalPath, full - cut));
+        if (!tail.isEmpty()) {
+            QFile file(journalPath);
+            QVERIFY(file.open(QIODevice::Append));
+            file.write(tail);
+        }
+
+        {
+            TimerManager manager;
+            TimerStore store(dir.path());
+            QVERIFY(store.load(&manager));
+            manager.attachStore(&store);
+            QCOMPARE(manager.count(), survived);
+            QCOMPARE(QFileInfo(journalPath).size(), survived == 3 ? full : intact);
+            manager.addTimer("d", std::chrono::seconds(40));
+        }
+
+        TimerManager manager;
+        TimerStore store(dir.path());
+        QVERIFY(store.load(&manager));
+        QStringList expected{"a", "b", "d"};
+        if (survived == 3) expected.insert(2, "c");
+        QCOMPARE(names(manager), expected);
+    }
+
+    // Знімок і журнал кожної старої версії читаються й одразу переписуються у версії 5
+    void storeMigration_data()
+    {
+        QTest::addColumn<int>("version");
+        for (int v = 1; v <= 4; ++v) QTest::addRow("v%d", v) << v;
+    }
+
+    void storeMigration()
+    {
+        QFETCH(int, version);
+        QTemporaryDir dir;
+        writeLegacyStore(dir.path(), version, QDateTime::currentMSecsSinceEpoch());
+        if (QTest::currentTestFailed()) return;
+
+        auto check = [version](const TimerManager &manager) {
+            QCOMPARE(manager.count(), 3);
+            TimerView tea = manager.getTimerById(1);
+            QCOMPARE(tea.name(), QString("Чай"));
+            QCOMPARE(tea.duration().count(), qint64(180000));
+            QCOMPARE(tea.remaining().count(), qint64(60000));
+            QVERIFY(!tea.running());
+            QCOMPARE(tea.schedule().kind, version >= 3 ? TimerSchedule::Repeat : TimerSchedule::Once);
+
+            TimerView lunch = manager.getTimerById(2);
+            QCOMPARE(lunch.duration().count(), qint64(3600000));
+            QVERIFY(lunch.running());
+            QVERIFY(lunch.remaining() > TimerDuration::zero() && lunch.remaining() <= TimerDuration(600000));
+
+            TimerView walk = manager.getTimerById(3);
+            QCOMPARE(walk.name(), QString("Прогулянка"));
+            QCOMPARE(walk.duration().count(), qint64(300000));
+            QVERIFY(!walk.running());
+            QVERIFY(manager.peekNextId() >= 4);
+        };
+
+        {
+            TimerManager manager;
+            TimerStore store(dir.path());
+            QVERIFY(store.load(&manager));
+            check(manager);
+            if (QTest::currentTestFailed()) return;
+        }
+
+        auto header = [&dir](const char *file) {
+            QFile f(QDir(dir.path()).filePath(file));
+            return f.open(QIODevice::ReadOnly) ? f.read(4) : QByteArray();
+        };
+        QCOMPARE(header("timers.snap"), QByteArray("STS5"));
+        QCOMPARE(header("timers.journal"), QByteArray("STJ5"));
+
+        // Переписаний знімок читається вже як поточна версія
+        TimerManager manager;
+        TimerStore store(dir.path());
+        QVERIFY(store.load(&manager));
+        check(manager);
+    }
+
+    // Місцевий час; порожній expected — розклад не настає ніколи
+    void cronNext_data()
+    {
+        QTest::addColumn<QString>("expression");
+        QTest::addColumn<QString>("from");
+        QTest::addColumn<QString>("expected");
+
+        // День місяця й день тижня обидва обмежені — досить збігу будь-якого
+        QTest::newRow("dom-or-dow-weekday") << "0 12 13 * 5" << "2024-09-01 00:00" << "2024-09-06 12:00";
+        QTest::newRow("dom-or-dow-both") << "0 12 13 * 5" << "2024-09-06 12:00" << "2024-09-13 12:00";
+        QTest::newRow("dom-or-dow-after") << "0 12 13 * 5" << "2024-09-13 12:00" << "2024-09-20 12:00";
+        QTest::newRow("dom-or-dow-monday") << "0 0 1 * 1" << "2024-01-02 00:00" << "2024-01-08 00:00";
+        QTest::newRow("leap-day-or-monday") << "0 0 29 2 1" << "2025-01-01 00:00" << "2025-02-03 00:00";
+        // Обмежене лише одне з полів — інше "*" нічого не додає
+        QTest::newRow("dow-only") << "0 9 * * 1" << "2024-09-03 10:00" << "2024-09-09 09:00";
+        QTest::newRow("dom-only") << "0 9 15 * *" << "2024-09-03 10:00" << "2024-09-15 09:00";
+        QTest::newRow("sunday-as-7") << "0 9 * * 7" << "2024-09-02 00:00" << "2024-09-08 09:00";
+        QTest::newRow("leap-day") << "0 0 29 2 *" << "2024-03-01 00:00" << "2028-02-29 00:00";
+        QTest::newRow("never") << "0 0 31 2 *" << "2024-01-01 00:00" << "";
+
+        // 31 березня 2024 о 03:00 годинник переводять на 04:00 — хвилин 03:00–03:59 того дня немає
+        QTest::newRow("dst-gap-daily") << "30 3 * * *" << "2024-03-31 00:00" << "2024-04-01 03:30";
+        QTest::newRow("dst-gap-step") << "*/15 * * * *" << "2024-03-31 02:50" << "2024-03-31 04:00";
+        QTest::newRow("dst-gap-before") << "30 2 * * *" << "2024-03-31 00:00" << "2024-03-31 02:30";
+        // 27 жовтня 2024 о 04:00 годинник повертають на 03:00 — 03:30 буває двічі
+        QTest::newRow("dst-overlap") << "30 3 * * *" << "2024-10-27 00:00" << "2024-10-27 03:30";
+    }
+
+    void cronNext()
+    {
+        QFETCH(QString, expression);
+        QFETCH(QString, from);
+        QFETCH(QString, expected);
+        const QString format = "yyyy-MM-dd HH:mm";
+
+        QString error;
+        CronSchedule cron = CronSchedule::parse(expression, &error);
+        QVERIFY2(cron.isValid(), qPrintable(error));
+        QDateTime start = QDateTime::fromString(from, format);
+        QVERIFY(start.isValid());
+
+        QDateTime next = cron.nextAfter(start);
+        if (expected.isEmpty()) {
+            QVERIFY(!next.isValid());
+            return;
+        }
+        QVERIFY(next.isValid());
+        QCOMPARE(next.toString(format), expected);
+        QVERIFY(next > start);
+    }
+
+    // Хвилина, що повторюється при поверненні годинника, спрацьовує один раз
+    void cronOverlapOnce()
+    {
+        CronSchedule cron = CronSchedule::parse("30 3 * * *");
+        QDateTime first = cron.nextAfter(QDateTime(QDate(2024, 10, 27), QTime(0, 0)));
+        QCOMPARE(first.toString("yyyy-MM-dd HH:mm"), QString("2024-10-27 03:30"));
+
+        // Після першого 03:30 (за літнім часом) і після другого (за зимовим) — уже наступний день
+        QCOMPARE(cron.nextAfter(first).toString("yyyy-MM-dd HH:mm"), QString("2024-10-28 03:30"));
+        QDateTime second = QDateTime::fromMSecsSinceEpoch(first.toMSecsSinceEpoch() + 3600 * 1000);
+        if (second.time() == QTime(3, 30))
+            QCOMPARE(cron.nextAfter(second).toString("yyyy-MM-dd HH:mm"), QString("2024-10-28 03:30"));
+
+        // Через мілісекунди від епохи — так розклад рахує менеджер
+        QCOMPARE(cron.nextAfterMs(first.toMSecsSinceEpoch()), QDateTime(QDate(2024, 10, 28), QTime(3, 30)).toMSecsSinceEpoch());
+    }
+
+    // Таймери спрацьовують у порядку дедлайнів, кожен рівно на своєму дедлайні й по одному timerFinished
+    void managerExpiryOrder()
+    {
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+
+        QVector<QPair<int, qint64>> finished;
+        connect(&manager, &TimerManager::timerFinished, this, [&](int id) {
+            finished.append({id, clock.monotonicMs()});
+        });
+        QSignalSpy spy(&manager, &TimerManager::timerFinished);
+
+        int a = manager.addTimer("A", TimerDuration(3000));
+        int b = manager.addTimer("B", TimerDuration(1000));
+        int c = manager.addTimer("C", TimerDuration(2000));
+        int d = manager.addTimer("D", TimerDuration(2500));
+        QCOMPARE(manager.startTimers({a, b, c, d}), 4);
+
+        clock.advance(TimerDuration(999));
+        QCOMPARE(spy.count(), 0);
+        QCOMPARE(manager.getTimerById(b).remaining(), TimerDuration(1));
+
+        clock.advance(TimerDuration(10000));
+        QCOMPARE(spy.count(), 4);
+        QVector<QPair<int, qint64>> expected{{b, 1000}, {c, 2000}, {d, 2500}, {a, 3000}};
+        QCOMPARE(finished, expected);
+        for (int id : {a, b, c, d}) {
+            QVERIFY(!manager.getTimerById(id).running());
+            QCOMPARE(manager.getTimerById(id).remaining(), TimerDuration::zero());
+        }
+        QCOMPARE(manager.runningCount(), 0);
+    }
+
+    // Повторюваний таймер після спрацювання перевзводиться від попереднього дедлайну і лишається запущеним
+    void managerRepeatRearm()
+    {
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+        QSignalSpy spy(&manager, &TimerManager::timerFinished);
+
+        int id = manager.addTimer("Повтор", TimerDuration(1500), TimerSchedule::repeat());
+        QVERIFY(manager.startTimer(id));
+
+        clock.advance(TimerDuration(1500));
+        QCOMPARE(spy.count(), 1);
+        QVERIFY(manager.getTimerById(id).running());
+        QCOMPARE(manager.getTimerById(id).remaining(), TimerDuration(1500));
+
+        clock.advance(TimerDuration(4000));
+        QCOMPARE(spy.count(), 3);
+        QVERIFY(manager.getTimerById(id).running());
+        QCOMPARE(manager.getTimerById(id).remaining(), TimerDuration(500));
+        for (const QList<QVariant> &args : spy) QCOMPARE(args.at(0).toInt(), id);
+    }
+
+    // Таймер за cron спрацьовує на хвилині розкладу за настінним часом і перевзводиться на наступну
+    void managerCronRearm()
+    {
+        // 2024-01-01 00:00 UTC — 02:00 за київським часом
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+        QSignalSpy spy(&manager, &TimerManager::timerFinished);
+
+        int id = manager.addTimer("Щогодини", TimerDuration::zero(), TimerSchedule::calendar(CronSchedule::parse("0 * * * *")));
+        QVERIFY(id > 0);
+        QVERIFY(manager.startTimer(id));
+        QCOMPARE(manager.getTimerById(id).remaining(), TimerDuration(3600 * 1000));
+
+        clock.advance(TimerDuration(3600 * 1000 - 1));
+        QCOMPARE(spy.count(), 0);
+        clock.advance(TimerDuration(1));
+        QCOMPARE(spy.count(), 1);
+        QVERIFY(manager.getTimerById(id).running());
+        QCOMPARE(manager.getTimerById(id).remaining(), TimerDuration(3600 * 1000));
+
+        clock.advance(TimerDuration(2 * 3600 * 1000));
+        QCOMPARE(spy.count(), 3);
+        QVERIFY(manager.getTimerById(id).running());
+    }
+
+    // Пауза групи зупиняє залишок її таймерів, не торкаючись таймерів поза групою
+    void managerPausedGroup()
+    {
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+        QSignalSpy spy(&manager, &TimerManager::timerFinished);
+
+        int group = manager.addGroup("Робота");
+        QVERIFY(group != 0);
+        int inGroup = manager.addTimer("У групі", TimerDuration(10000));
+        int outside = manager.addTimer("Поза групою", TimerDuration(10000));
+        QVERIFY(manager.setTimerGroup(inGroup, group));
+        QCOMPARE(manager.startTimers({inGroup, outside}), 2);
+
+        clock.advance(TimerDuration(4000));
+        QVERIFY(manager.pauseGroup(group));
+        clock.advance(TimerDuration(3600 * 1000));
+
+        // Поза групою таймер відпрацював, а в групі — стоїть на тих самих 6 с, але лишається запущеним
+        QCOMPARE(spy.count(), 1);
+        QCOMPARE(spy.at(0).at(0).toInt(), outside);
+        TimerView t = manager.getTimerById(inGroup);
+        QVERIFY(t.running());
+        QVERIFY(!t.ticking());
+        QCOMPARE(t.remaining(), TimerDuration(6000));
+
+        QVERIFY(manager.resumeGroup(group));
+        clock.advance(TimerDuration(5999));
+        QCOMPARE(spy.count(), 1);
+        clock.advance(TimerDuration(1));
+        QCOMPARE(spy.count(), 2);
+        QCOMPARE(spy.at(1).at(0).toInt(), inGroup);
+        QVERIFY(!manager.getTimerById(inGroup).running());
+    }
+
+    // Після першого snapshot() кожна зміна, зокрема й addTimer, публікується зі зведеним сповіщенням
+    void managerPublishesAdds()
+    {
+        SimulatedClock clock;
+        TimerManager manager;
+        manager.setClock(&clock);
+        int first = manager.addTimer("Перший", TimerDuration(1000));
+        QVERIFY(manager.snapshot().find(first));
+
+        int second = manager.addTimer("Другий", TimerDuration(1000));
+        QVERIFY(!manager.latestSnapshot().find(second));
+        clock.advance(TimerDuration(manager.updateInterval()));
+        TimerSnapshot published = manager.latestSnapshot();
+        QVERIFY(published.find(second));
+        QCOMPARE(published.count(), 2);
+    }
+
+    // Оцінка пам'яті на таймер: компактний режим дешевший за звичайний на тих самих таймерах,
+    // а кожна частина оцінки росте з кількістю таймерів
+    void memoryPerTimer()
+    {
+        const int count = 20000;
+        TimerManager::MemoryUsage usage[2];
+        for (bool compact : {false, true}) {
+            TimerManager manager;
+            manager.setCompactMode(compact);
+            QList<int> ids;
+            for (int i = 0; i < count; ++i)
+                ids.append(manager.addTimer(QString("таймер-%1").arg(i), std::chrono::seconds(60 + i % 3600)));
+            manager.startTimers(ids);
+            QVERIFY(!manager.nextToExpire(1).isEmpty());   // порядок спрацювання будується при першому запиті
+
+            TimerManager::MemoryUsage u = manager.memoryUsage();
+            QCOMPARE(u.timers, count);
+            QVERIFY(u.storage >= qint64(count) * 8);
+            QVERIFY(u.indexes >= qint64(count) * qint64(sizeof(int)));
+            QVERIFY(u.scheduling > 0);
+            qInfo("%s: %.1f байт на таймер (сховище %.1f, індекси %.1f, планування %.1f)",
+                  compact ? "компактний" : "звичайний", u.bytesPerTimer(), double(u.storage) / count,
+                  double(u.indexes) / count, double(u.scheduling) / count);
+            usage[compact] = u;
+        }
+        QVERIFY(usage[true].storage < usage[false].storage);
+        QVERIFY(usage[true].indexes < usage[false].indexes);
+        QVERIFY(usage[true].bytesPerTimer() < usage[false].bytesPerTimer());
+    }
+
+    // Лапки за RFC 4180: кома й переведення рядка в полі, подвоєні лапки; номери рядків після
+    // багаторядкового поля не зсуваються, а зіпсовані рядки не зупиняють імпорт
+    void csvQuotedAndMalformed()
+    {
+        QTemporaryDir dir;
+        QString path = writeFile(dir, "timers.csv",
+                                 "name,duration,schedule\n"
+                                 "\"Кава, з молоком\",00:05:00,\n"
+                                 "\"Він сказав \"\"так\"\"\",90,repeat\n"
+                                 "\"Два\nрядки\",10,\n"
+                                 ",10,\n"
+                                 "Погана,abc,\n"
+                                 "Крон,,0 9 * * 1-5\n"
+                                 "Поганий крон,10,99 * * * *\n");
+        Parsed parsed = parse(path);
+        QVERIFY(parsed.result.error.isEmpty());
+        QCOMPARE(parsed.result.parsed, 4);
+        QCOMPARE(parsed.result.invalid, 3);
+
+        QCOMPARE(parsed.timers.size(), 4);
+        QCOMPARE(parsed.timers[0].name, QString("Кава, з молоком"));
+        QCOMPARE(parsed.timers[0].duration.count(), qint64(300000));
+        QCOMPARE(parsed.timers[1].name, QString("Він сказав \"так\""));
+        QCOMPARE(parsed.timers[1].duration.count(), qint64(90000));
+        QCOMPARE(parsed.timers[1].schedule.kind, TimerSchedule::Repeat);
+        QCOMPARE(parsed.timers[2].name, QString("Два\nрядки"));
+        QCOMPARE(parsed.timers[3].name, QString("Крон"));
+        QCOMPARE(parsed.timers[3].schedule.kind, TimerSchedule::Calendar);
+        QCOMPARE(parsed.lines, (QVector<int>{2, 3, 4, 8}));
+
+        QCOMPARE(parsed.result.errors.size(), 3);
+        QVERIFY(parsed.result.errors[0].startsWith("Рядок 6:"));
+        QVERIFY(parsed.result.errors[1].startsWith("Рядок 7:"));
+        QVERIFY(parsed.result.errors[2].startsWith("Рядок 9:"));
+    }
+
+    // Без заголовка колонки йдуть за порядком; крапка з комою, CRLF і BOM з електронних таблиць
+    void csvSemicolonWithoutHeader()
+    {
+        QTemporaryDir dir;
+        QString path = writeFile(dir, "timers.csv", "\xEF\xBB\xBFЧай;180\r\nОбід;01:00:00;once\r\n");
+        Parsed parsed = parse(path);
+        QCOMPARE(parsed.result.invalid, 0);
+        QCOMPARE(parsed.timers.size(), 2);
+        QCOMPARE(parsed.timers[0].name, QString("Чай"));
+        QCOMPARE(parsed.timers[0].duration.count(), qint64(180000));
+        QCOMPARE(parsed.timers[1].name, QString("Обід"));
+        QCOMPARE(parsed.timers[1].duration.count(), qint64(3600000));
+        QCOMPARE(parsed.lines, (QVector<int>{1, 2}));
+    }
+
+    void jsonLinesMalformed()
+    {
+        QTemporaryDir dir;
+        QString path = writeFile(dir, "timers.jsonl",
+                                 "{\"name\":\"A\",\"duration\":\"00:01:00\"}\n"
+                                 "{\"name\":\"B\",\"duration_ms\":1500}\n"
+                                 "{\"name\":\"C\",\"duration\":1.5}\n"
+                                 "{\"name\":\"D\"\n"
+                                 "[1,2]\n"
+                                 "\n"
+                                 "{\"назва\":\"Е\",\"тривалість\":30,\"розклад\":\"repeat\"}\n"
+                                 "{\"name\":\"F\",\"duration\":\"x\"}\n");
+        Parsed parsed = parse(path);
+        QCOMPARE(parsed.result.parsed, 3);
+        QCOMPARE(parsed.result.invalid, 4);
+        QCOMPARE(parsed.lines, (QVector<int>{1, 2, 7}));
+        QCOMPARE(parsed.timers[0].duration.count(), qint64(60000));
+        QCOMPARE(parsed.timers[1].duration.count(), qint64(1500));
+        QCOMPARE(parsed.timers[2].name, QString("Е"));
+        QCOMPARE(parsed.timers[2].duration.count(), qint64(30000));
+        QCOMPARE(parsed.timers[2].schedule.kind, TimerSchedule::Repeat);
+
+        const QStringList &errors = parsed.result.errors;
+        QCOMPARE(errors.size(), 4);
+        QVERIFY(errors[0].startsWith("Рядок 3:"));
+        QVERIFY(errors[0].contains("цілим числом"));
+        QVERIFY(errors[1].startsWith("Рядок 4:"));
+        QVERIFY(errors[2].startsWith("Рядок 5:"));
+        QVERIFY(errors[3].startsWith("Рядок 8:"));
+
+        // Зайняту назву відхиляє вже менеджер — з номером рядка файлу
+        TimerManager manager;
+        manager.addTimer("A", std::chrono::seconds(5));
+        TimerTransfer::ImportResult result = TimerTransfer::importFile(&manager, path, TimerTransfer::JsonLines);
+        QCOMPARE(result.added, 2);
+        QCOMPARE(result.rejected, 5);
+        QVERIFY(result.errors.last().startsWith("Рядок 1:"));
+        QCOMPARE(manager.count(), 3);
+    }
+};
+
+QTEST_GUILESS_MAIN(SmartTimerTests)
+
+#include "SmartTimerTests.moc"